@@ -0,0 +1,86 @@
+"""
+Host decoder for the WLED serial delta stream.
+
+Sending 'D' to WLED over serial starts continuous streaming of the LED colors. This is a WLED extension of TPM2 and
+not part of the TPM2 specification. Every frame starts with 0xC9 and ends with 0x36 followed by a newline:
+
+  keyframe (TPM2 data frame): 0xC9 0xDA <length hi> <lo> <RGB of every LED> 0x36 '\\n'
+  delta frame:                0xC9 0xDD <length hi> <lo> { <start pixel hi> <lo> <run length> <RGB * run length> } 0x36 '\\n'
+
+Delta frames only hold the pixel runs changed since the previous frame. A keyframe is sent first, every 100 frames,
+and whenever the LED count changes. Sending any other byte (e.g. 'o') stops the stream.
+"""
+import sys
+
+
+class WledSerialDeltaDecoder:
+    KEYFRAME = 0xDA
+    DELTA = 0xDD
+
+    def __init__(self):
+        self.pixels = None  # bytearray of RGB, None until the first keyframe
+        self._buf = bytearray()
+
+    def feed(self, data):
+        """Adds received bytes, returns the number of frames decoded."""
+        self._buf.extend(data)
+        frames = 0
+        while True:
+            start = self._buf.find(0xC9)
+            if start < 0:
+                self._buf.clear()
+                return frames
+            del self._buf[:start]
+            if len(self._buf) < 4:
+                return frames
+            ptype = self._buf[1]
+            length = (self._buf[2] << 8) | self._buf[3]
+            if ptype not in (self.KEYFRAME, self.DELTA):
+                del self._buf[:1]  # not a frame start, resync
+                continue
+            if len(self._buf) < 5 + length:
+                return frames
+            if self._buf[4 + length] != 0x36:
+                del self._buf[:1]  # corrupt frame, resync
+                continue
+            payload = bytes(self._buf[4:4 + length])
+            del self._buf[:5 + length]
+            if self._apply(ptype, payload):
+                frames += 1
+
+    def _apply(self, ptype, payload):
+        if ptype == self.KEYFRAME:
+            self.pixels = bytearray(payload)
+            return True
+        if self.pixels is None:
+            return False  # delta without a base, wait for the next keyframe
+        i = 0
+        while i + 3 <= len(payload):
+            start = (payload[i] << 8) | payload[i + 1]
+            count = payload[i + 2]
+            run = payload[i + 3:i + 3 + count * 3]
+            if len(run) != count * 3 or (start + count) * 3 > len(self.pixels):
+                self.pixels = None  # inconsistent with our base, wait for the next keyframe
+                return False
+            self.pixels[start * 3:(start + count) * 3] = run
+            i += 3 + count * 3
+        return True
+
+    def rgb(self, i):
+        return tuple(self.pixels[i * 3:i * 3 + 3])
+
+
+################################## serial stream test ##################################
+if __name__ == "__main__":
+    import serial  # pyserial
+    port = sys.argv[1] if len(sys.argv) > 1 else "/dev/ttyUSB0"
+    baud = int(sys.argv[2]) if len(sys.argv) > 2 else 115200
+    decoder = WledSerialDeltaDecoder()
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        ser.write(b'D')
+        try:
+            while True:
+                if decoder.feed(ser.read(4096)) and decoder.pixels:
+                    print(len(decoder.pixels) // 3, "LEDs, first:", decoder.rgb(0))
+        except KeyboardInterrupt:
+            ser.write(b'o')
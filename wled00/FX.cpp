@@ -331,7 +331,7 @@ uint16_t mode_dynamic(void) {
 
   if(SEGENV.call == 0) {
     //SEGMENT.fill(BLACK);
-    for (unsigned i = 0; i < SEGLEN; i++) SEGENV.data[i] = hw_random8();
+    SEGMENT.prngFill(SEGENV.data, SEGLEN);
   }
 
   uint32_t cycleTime = 50 + (255 - SEGMENT.speed)*15;
@@ -339,7 +339,7 @@ uint16_t mode_dynamic(void) {
   if (it != SEGENV.step && SEGMENT.speed != 0) //new color
   {
     for (unsigned i = 0; i < SEGLEN; i++) {
-      if (hw_random8() <= SEGMENT.intensity) SEGENV.data[i] = hw_random8(); // random color index
+      if (SEGMENT.prng8() <= SEGMENT.intensity) SEGENV.data[i] = SEGMENT.prng8(); // random color index
     }
     SEGENV.step = it;
   }
@@ -655,9 +655,9 @@ uint16_t dissolve(uint32_t color) {
   }
 
   for (unsigned j = 0; j <= SEGLEN / 15; j++) {
-    if (hw_random8() <= SEGMENT.intensity) {
+    if (SEGMENT.prng8() <= SEGMENT.intensity) {
       for (size_t times = 0; times < 10; times++) { //attempt to spawn a new pixel 10 times
-        unsigned i = hw_random16(SEGLEN);
+        unsigned i = SEGMENT.prng16(SEGLEN);
         if (SEGENV.aux0) { //dissolve to primary/palette
           if (pixels[i] == SEGCOLOR(1)) {
             pixels[i] = color == SEGCOLOR(0) ? SEGMENT.color_from_palette(i, true, PALETTE_SOLID_WRAP, 0) : color;
@@ -1325,7 +1325,7 @@ uint16_t mode_fire_flicker(void) {
   byte lum = (SEGMENT.palette == 0) ? MAX(w, MAX(r, MAX(g, b))) : 255;
   lum /= (((256-SEGMENT.intensity)/16)+1);
   for (unsigned i = 0; i < SEGLEN; i++) {
-    byte flicker = hw_random8(lum);
+    byte flicker = SEGMENT.prng8(lum);
     if (SEGMENT.palette == 0) {
       SEGMENT.setPixelColor(i, MAX(r - flicker, 0), MAX(g - flicker, 0), MAX(b - flicker, 0), MAX(w - flicker, 0));
     } else {
@@ -2110,7 +2110,7 @@ uint16_t mode_fire_2012() {
 
       // Step 1.  Cool down every cell a little
       for (unsigned i = 0; i < SEGLEN; i++) {
-        uint8_t cool = (it != SEGENV.step) ? hw_random8((((20 + SEGMENT.speed/3) * 16) / SEGLEN)+2) : hw_random8(4);
+        uint8_t cool = (it != SEGENV.step) ? SEGMENT.prng8((((20 + SEGMENT.speed/3) * 16) / SEGLEN)+2) : SEGMENT.prng8(4);
         uint8_t minTemp = (i<ignition) ? (ignition-i)/4 + 16 : 0;  // should not become black in ignition area
         uint8_t temp = qsub8(heat[i], cool);
         heat[i] = temp<minTemp ? minTemp : temp;
@@ -2206,10 +2206,11 @@ uint16_t mode_noise16_2() {
   unsigned scale = 1000;                                        // the "zoom factor" for the noise
   SEGENV.step += (1 + (SEGMENT.speed >> 1));
 
+  unsigned shift_x = SEGENV.step >> 6;                          // x as a function of time
+  uint16_t noiseRow[32];                                        // noise is calculated in batches of 32 pixels
   for (unsigned i = 0; i < SEGLEN; i++) {
-    unsigned shift_x = SEGENV.step >> 6;                        // x as a function of time
-    uint32_t real_x = (i + shift_x) * scale;                    // calculate the coordinates within the noise field
-    unsigned noise = perlin16(real_x, 0, 4223) >> 8;            // get the noise data and scale it down
+    if ((i & 31) == 0) perlin16Row(noiseRow, MIN(32U, SEGLEN - i), (i + shift_x) * scale, scale, 0, 4223); // calculate the coordinates within the noise field
+    unsigned noise = noiseRow[i & 31] >> 8;                     // get the noise data and scale it down
     unsigned index = sin8_t(noise * 3);                           // map led color based on noise data
 
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, noise));
@@ -2244,8 +2245,10 @@ static const char _data_FX_MODE_NOISE16_3[] PROGMEM = "Noise 3@!;!;!;;pal=35";
 //https://github.com/aykevl/ledstrip-spark/blob/master/ledstrip.ino
 uint16_t mode_noise16_4() {
   uint32_t stp = (strip.now * SEGMENT.speed) >> 7;
+  uint16_t noiseRow[32]; // noise is calculated in batches of 32 pixels
   for (unsigned i = 0; i < SEGLEN; i++) {
-    int index = perlin16(uint32_t(i) << 12, stp);
+    if ((i & 31) == 0) perlin16Row(noiseRow, MIN(32U, SEGLEN - i), uint32_t(i) << 12, 1U << 12, stp);
+    int index = noiseRow[i & 31];
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0));
   }
   return FRAMETIME;
@@ -3827,10 +3830,14 @@ uint16_t mode_plasma(void) {
   unsigned thisPhase = beatsin8_t(6+SEGENV.aux0,-64,64);
   unsigned thatPhase = beatsin8_t(7+SEGENV.aux0,-64,64);
 
+  unsigned thatStep = 1 + 2*(SEGMENT.speed >> 5);
+  uint8_t  dimming  = beatsin8_t(7,0, (128 - (SEGMENT.intensity>>1)));
+  uint8_t  cosWave[32];
   for (unsigned i = 0; i < SEGLEN; i++) {   // For each of the LED's in the strand, set color &  brightness based on a wave as follows:
+    if ((i & 31) == 0) cos8Span(cosWave, 32, i*thatStep + thatPhase, thatStep); // next 32 values of the 2nd wave
     unsigned colorIndex = cubicwave8((i*(2+ 3*(SEGMENT.speed >> 5))+thisPhase) & 0xFF)/2   // factor=23 // Create a wave and add a phase change and add another wave with its own phase change.
-                              + cos8_t((i*(1+ 2*(SEGMENT.speed >> 5))+thatPhase) & 0xFF)/2;  // factor=15 // Hey, you can even change the frequencies if you wish.
-    unsigned thisBright = qsub8(colorIndex, beatsin8_t(7,0, (128 - (SEGMENT.intensity>>1))));
+                              + cosWave[i & 31]/2;  // factor=15 // Hey, you can even change the frequencies if you wish.
+    unsigned thisBright = qsub8(colorIndex, dimming);
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(colorIndex, false, PALETTE_SOLID_WRAP, 0, thisBright));
   }
 
@@ -4803,9 +4810,14 @@ static const char _data_FX_MODE_PERLINMOVE[] PROGMEM = "Perlin Move@!,# of pixel
 // Uses beatsin8() + phase shifting. By: Andrew Tuline
 uint16_t mode_wavesins(void) {
 
+  uint8_t briWave[32], indexWave[32];
   for (unsigned i = 0; i < SEGLEN; i++) {
-    uint8_t bri = sin8_t(strip.now/4 + i * SEGMENT.intensity);
-    uint8_t index = beatsin8_t(SEGMENT.speed, SEGMENT.custom1, SEGMENT.custom1+SEGMENT.custom2, 0, i * (SEGMENT.custom3<<3)); // custom3 is reduced resolution slider
+    if ((i & 31) == 0) { // next 32 values of both waves
+      sin8Span(briWave, 32, strip.now/4 + i * SEGMENT.intensity, SEGMENT.intensity);
+      beatsin8Span(indexWave, 32, SEGMENT.speed, SEGMENT.custom1, SEGMENT.custom1+SEGMENT.custom2, 0, i * (SEGMENT.custom3<<3), SEGMENT.custom3<<3); // custom3 is reduced resolution slider
+    }
+    uint8_t bri = briWave[i & 31];
+    uint8_t index = indexWave[i & 31];
     //SEGMENT.setPixelColor(i, ColorFromPalette(SEGPALETTE, index, bri, LINEARBLEND));
     SEGMENT.setPixelColor(i, SEGMENT.color_from_palette(index, false, PALETTE_SOLID_WRAP, 0, bri));
   }
@@ -5047,12 +5059,14 @@ uint16_t mode_2Dfirenoise(void) {               // firenoise2d. By Andrew Tuline
                                                                   CRGB::Red,       CRGB::Red,        CRGB::Red,    CRGB::DarkOrange,
                                                                   CRGB::DarkOrange,CRGB::DarkOrange, CRGB::Orange, CRGB::Orange,
                                                                   CRGB::Yellow,    CRGB::Orange,     CRGB::Yellow, CRGB::Yellow);
-  for (int j=0; j < cols; j++) {
-    for (int i=0; i < rows; i++) {
-      indexx = perlin8(j*yscale*rows/255, i*xscale+strip.now/4);                                               // We're moving along our Perlin map.
+  uint8_t noiseRow[32]; // noise is calculated in batches of 32 pixels
+  for (int i=0; i < rows; i++) {
+    for (int j=0; j < cols; j++) {
+      if ((j & 31) == 0) perlin8Row(noiseRow, MIN(32, cols - j), j*(yscale*rows/255), yscale*rows/255, i*xscale+strip.now/4); // We're moving along our Perlin map.
+      indexx = noiseRow[j & 31];
       SEGMENT.setPixelColorXY(j, i, ColorFromPalette(pal, min(i*indexx/11, 225U), i*255/rows, LINEARBLEND));   // With that value, look up the 8 bit colour palette value and assign it to the current LED.    
-    } // for i
-  } // for j
+    } // for j
+  } // for i
 
   return FRAMETIME;
 } // mode_2Dfirenoise()
@@ -5083,108 +5097,121 @@ static const char _data_FX_MODE_2DFRIZZLES[] PROGMEM = "Frizzles@X frequency,Y f
 ///////////////////////////////////////////
 //   2D Cellular Automata Game of life   //
 ///////////////////////////////////////////
-typedef struct ColorCount {
-  CRGB color;
-  int8_t count;
-} colorCount;
-
+// cells are bit-packed (32 per word, each row starts at a word boundary) and neighbours are counted
+// for 32 cells at once using bit-sliced adders; colors are kept as palette indices in a separate layer
 uint16_t mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https://natureofcode.com/book/chapter-7-cellular-automata/ and https://github.com/DougHaber/nlife-color
   if (!strip.isMatrix || !SEGMENT.is2D()) return mode_static(); // not a 2D set-up
 
   const int cols = SEG_W;
   const int rows = SEG_H;
-  const auto XY = [&](int x, int y) { return (x%cols) + (y%rows) * cols; };
-  const unsigned dataSize = sizeof(CRGB) * SEGMENT.length();  // using width*height prevents reallocation if mirroring is enabled
-  const int crcBufferLen = 2; //(SEGMENT.width() + SEGMENT.height())*71/100; // roughly sqrt(2)/2 for better repetition detection (Ewowi)
-
-  if (!SEGENV.allocateData(dataSize + sizeof(uint16_t)*crcBufferLen)) return mode_static(); //allocation failed
-  CRGB *prevLeds = reinterpret_cast<CRGB*>(SEGENV.data);
-  uint16_t *crcBuffer = reinterpret_cast<uint16_t*>(SEGENV.data + dataSize); 
-
-  CRGB backgroundColor = SEGCOLOR(1);
+  const unsigned wordsPerRow = (cols + 31) / 32;
+  const unsigned maxDim    = max(SEGMENT.width(), SEGMENT.height()); // grid fits either orientation, so transpose does not reallocate
+  const unsigned gridSize  = sizeof(uint32_t) * ((maxDim + 31) / 32) * maxDim; // using width/height prevents reallocation if mirroring is enabled
+  const unsigned colorSize = SEGMENT.length();
+  const int hashBufferLen = 8; // detects still lifes and oscillators with period of up to 8 generations
+
+  if (!SEGENV.allocateData(2 * gridSize + colorSize + sizeof(uint32_t)*hashBufferLen)) return mode_static(); //allocation failed
+  uint32_t *grid       = reinterpret_cast<uint32_t*>(SEGENV.data);            // current generation
+  uint32_t *nextGrid   = reinterpret_cast<uint32_t*>(SEGENV.data + gridSize); // next generation
+  uint32_t *hashBuffer = reinterpret_cast<uint32_t*>(SEGENV.data + 2*gridSize);
+  uint8_t  *cellColors = reinterpret_cast<uint8_t*>(SEGENV.data + 2*gridSize + sizeof(uint32_t)*hashBufferLen); // palette index of each cell
+  const uint32_t lastWordMask = (cols & 31) ? (1U << (cols & 31)) - 1 : 0xFFFFFFFFU; // unused bits of the last word in a row are kept 0
+
+  const auto getCell = [&](const uint32_t *row, int x) { return (row[x >> 5] >> (x & 31)) & 1U; };
+  const uint32_t bgColor = SEGCOLOR(1);
 
   if (SEGENV.call == 0 || strip.now - SEGMENT.step > 3000) {
     SEGENV.step = strip.now;
     SEGENV.aux0 = 0;
 
-    //give the leds random state and colors (based on intensity, colors from palette or all posible colors are chosen)
-    for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) {
-      unsigned state = hw_random8()%2;
-      if (state == 0)
-        SEGMENT.setPixelColorXY(x,y, backgroundColor);
-      else
-        SEGMENT.setPixelColorXY(x,y, SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 255));
+    //give the cells random state and colors from palette
+    memset(grid, 0, gridSize);
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
+      if (SEGMENT.prng8() & 1) {
+        grid[y * wordsPerRow + (x >> 5)] |= 1U << (x & 31);
+        cellColors[x + y * cols] = SEGMENT.prng8();
+      }
     }
-
-    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) prevLeds[XY(x,y)] = CRGB::Black;
-    memset(crcBuffer, 0, sizeof(uint16_t)*crcBufferLen);
+    memset(hashBuffer, 0, sizeof(uint32_t)*hashBufferLen);
   } else if (strip.now - SEGENV.step < FRAMETIME_FIXED * (uint32_t)map(SEGMENT.speed,0,255,64,4)) {
     // update only when appropriate time passes (in 42 FPS slots)
     return FRAMETIME;
-  }
-
-  //copy previous leds (save previous generation)
-  //NOTE: using lossy getPixelColor() is a benefit as endlessly repeating patterns will eventually fade out causing a reset
-  for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) prevLeds[XY(x,y)] = SEGMENT.getPixelColorXY(x,y);
-
-  //calculate new leds
-  for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) {
-
-    colorCount colorsCount[9]; // count the different colors in the 3*3 matrix
-    for (int i=0; i<9; i++) colorsCount[i] = {backgroundColor, 0}; // init colorsCount
-
-    // iterate through neighbors and count them and their different colors
-    int neighbors = 0;
-    for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) { // iterate through 3*3 matrix
-      if (i==0 && j==0) continue; // ignore itself
-      // wrap around segment
-      int xx = x+i, yy = y+j;
-      if (x+i < 0) xx = cols-1; else if (x+i >= cols) xx = 0;
-      if (y+j < 0) yy = rows-1; else if (y+j >= rows) yy = 0;
-
-      unsigned xy = XY(xx, yy); // previous cell xy to check
-      // count different neighbours and colors
-      if (prevLeds[xy] != backgroundColor) {
-        neighbors++;
-        bool colorFound = false;
-        int k;
-        for (k=0; k<9 && colorsCount[k].count != 0; k++)
-          if (colorsCount[k].color == prevLeds[xy]) {
-            colorsCount[k].count++;
-            colorFound = true;
+  } else {
+    // calculate next generation, 32 cells at a time
+    for (int y = 0; y < rows; y++) {
+      const uint32_t *above = &grid[((y + rows - 1) % rows) * wordsPerRow]; // wrap around segment
+      const uint32_t *row   = &grid[y * wordsPerRow];
+      const uint32_t *below = &grid[((y + 1) % rows) * wordsPerRow];
+      const uint32_t *r3[3] = {above, row, below};
+      for (unsigned w = 0; w < wordsPerRow; w++) {
+        // bit-sliced neighbour count (s2 is sticky, so it is set for any count >= 4)
+        uint32_t s0 = 0, s1 = 0, s2 = 0;
+        const auto add = [&](uint32_t v) { uint32_t c0 = s0 & v; s0 ^= v; uint32_t c1 = s1 & c0; s1 ^= c0; s2 |= c1; };
+        for (int i = 0; i < 3; i++) {
+          const uint32_t *r = r3[i];
+          // west neighbour of cell x is x-1, east neighbour is x+1 (wrapping around segment)
+          uint32_t west = (r[w] << 1) | (w > 0 ? r[w-1] >> 31 : getCell(r, cols-1));
+          uint32_t east = (r[w] >> 1) | (w < wordsPerRow-1 ? r[w+1] << 31 : 0);
+          if (w == wordsPerRow-1) east |= getCell(r, 0) << ((cols-1) & 31);
+          add(west);
+          add(east);
+          if (i != 1) add(r[w]); // cell itself is not a neighbour
+        }
+        const uint32_t cell   = row[w];
+        const uint32_t mask   = (w == wordsPerRow-1) ? lastWordMask : 0xFFFFFFFFU;
+        const uint32_t two    = ~s2 & s1 & ~s0 & mask;
+        const uint32_t three  = ~s2 & s1 &  s0 & mask;
+        uint32_t next = (cell & (two | three));  // survival (Loneliness & Overpopulation kill all others)
+        // Reproduction: dead cells with 3 neighbours
+        uint32_t born = three & ~cell;
+        while (born) {
+          const int b = __builtin_ctz(born);
+          born &= born - 1;
+          if (!SEGMENT.prng8(128)) continue; // a bit of randomness to avoid "gliders"
+          const int x = (w << 5) + b;
+          // find dominant color (first one found if there is a tie) and assign it to a cell
+          uint8_t c[3];
+          int n = 0;
+          for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) {
+            if (i==0 && j==0) continue; // ignore itself
+            const int xx = (x + i + cols) % cols, yy = (y + j + rows) % rows;
+            if (n < 3 && getCell(&grid[yy * wordsPerRow], xx)) c[n++] = cellColors[xx + yy * cols];
           }
-        if (!colorFound) colorsCount[k] = {prevLeds[xy], 1}; //add new color found in the array
+          cellColors[x + y * cols] = (c[1] == c[2]) ? c[1] : c[0];
+          next |= 1U << b;
+        }
+        // Mutation: dead cells with 2 neighbours
+        uint32_t mutate = two & ~cell;
+        while (mutate) {
+          const int b = __builtin_ctz(mutate);
+          mutate &= mutate - 1;
+          if (SEGMENT.prng8(128)) continue;
+          cellColors[(w << 5) + b + y * cols] = SEGMENT.prng8();
+          next |= 1U << b;
+        }
+        nextGrid[y * wordsPerRow + w] = next;
       }
-    } // i,j
-
-    // Rules of Life
-    uint32_t col = uint32_t(prevLeds[XY(x,y)]) & 0x00FFFFFF;  // uint32_t operator returns RGBA, we want RGBW -> cut off "alpha" byte
-    uint32_t bgc = RGBW32(backgroundColor.r, backgroundColor.g, backgroundColor.b, 0);
-    if      ((col != bgc) && (neighbors <  2)) SEGMENT.setPixelColorXY(x,y, bgc); // Loneliness
-    else if ((col != bgc) && (neighbors >  3)) SEGMENT.setPixelColorXY(x,y, bgc); // Overpopulation
-    else if ((col == bgc) && (neighbors == 3)) {                                  // Reproduction
-      // find dominant color and assign it to a cell
-      colorCount dominantColorCount = {backgroundColor, 0};
-      for (int i=0; i<9 && colorsCount[i].count != 0; i++)
-        if (colorsCount[i].count > dominantColorCount.count) dominantColorCount = colorsCount[i];
-      // assign the dominant color w/ a bit of randomness to avoid "gliders"
-      if (dominantColorCount.count > 0 && hw_random8(128)) SEGMENT.setPixelColorXY(x,y, dominantColorCount.color);
-    } else if ((col == bgc) && (neighbors == 2) && !hw_random8(128)) {               // Mutation
-      SEGMENT.setPixelColorXY(x,y, SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 255));
-    }
-    // else do nothing!
-  } //x,y
-
-  // calculate CRC16 of leds
-  uint16_t crc = crc16((const unsigned char*)prevLeds, dataSize);
-  // check if we had same CRC and reset if needed
-  bool repetition = false;
-  for (int i=0; i<crcBufferLen && !repetition; i++) repetition = (crc == crcBuffer[i]); // (Ewowi)
-  // same CRC would mean image did not change or was repeating itself
-  if (!repetition) SEGENV.step = strip.now; //if no repetition avoid reset
-  // remember CRCs across frames
-  crcBuffer[SEGENV.aux0] = crc;
-  ++SEGENV.aux0 %= crcBufferLen;
+    }
+    memcpy(grid, nextGrid, sizeof(uint32_t) * wordsPerRow * rows);
+
+    // check if the pattern repeats itself (image did not change or is oscillating)
+    uint32_t hash = 2166136261U; // FNV-1a over all cells
+    for (unsigned i = 0; i < wordsPerRow * rows; i++) hash = (hash ^ grid[i]) * 16777619U;
+    bool repetition = false;
+    for (int i=0; i<hashBufferLen && !repetition; i++) repetition = (hash == hashBuffer[i]);
+    if (!repetition) SEGENV.step = strip.now; //if no repetition avoid reset
+    // remember hashes across generations
+    hashBuffer[SEGENV.aux0] = hash;
+    ++SEGENV.aux0 %= hashBufferLen;
+  }
+
+  // draw cells
+  for (int y = 0; y < rows; y++) {
+    const uint32_t *row = &grid[y * wordsPerRow];
+    for (int x = 0; x < cols; x++) {
+      SEGMENT.setPixelColorXY(x, y, getCell(row, x) ? SEGMENT.color_from_palette(cellColors[x + y * cols], false, PALETTE_SOLID_WRAP, 255) : bgColor);
+    }
+  }
 
   return FRAMETIME;
 } // mode_2Dgameoflife()
@@ -5452,37 +5479,39 @@ uint16_t mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have
   int x1 = beatsin8_t(23 * speed, 0, cols-1);
   int y1 = beatsin8_t(28 * speed, 0, rows-1);
 
+  const int px[3] = {x1, x2, x3};
+  const int py[3] = {y1, y2, y3};
   for (int y = 0; y < rows; y++) {
-    for (int x = 0; x < cols; x++) {
-      // calculate distances of the 3 points from actual pixel
+    for (int x0 = 0; x0 < cols; x0 += 32) { // 32 pixels of a row at a time
+      const int n = min(cols - x0, 32);
+      // calculate distances of the 3 points from actual pixels
       // and add them together with weightening
-      unsigned dx = abs(x - x1);
-      unsigned dy = abs(y - y1);
-      unsigned dist = 2 * sqrt32_bw((dx * dx) + (dy * dy));
-
-      dx = abs(x - x2);
-      dy = abs(y - y2);
-      dist += sqrt32_bw((dx * dx) + (dy * dy));
-
-      dx = abs(x - x3);
-      dy = abs(y - y3);
-      dist += sqrt32_bw((dx * dx) + (dy * dy));
+      unsigned dist[32] = {0};
+      for (int p = 0; p < 3; p++) {
+        int16_t dx[32], dy[32];
+        uint16_t d[32];
+        for (int i = 0; i < n; i++) { dx[i] = x0 + i - px[p]; dy[i] = y - py[p]; }
+        hypotSpan(d, dx, dy, n, MATH_EXACT);
+        for (int i = 0; i < n; i++) dist[i] += (p == 0) ? 2 * d[i] : d[i];
+      }
 
-      // inverse result
-      int color = dist ? 1000 / dist : 255;
+      for (int i = 0; i < n; i++) {
+        // inverse result
+        int color = dist[i] ? 1000 / dist[i] : 255;
 
-      // map color between thresholds
-      if (color > 0 and color < 60) {
-        SEGMENT.setPixelColorXY(x, y, SEGMENT.color_from_palette(map(color * 9, 9, 531, 0, 255), false, PALETTE_SOLID_WRAP, 0));
-      } else {
-        SEGMENT.setPixelColorXY(x, y, SEGMENT.color_from_palette(0, false, PALETTE_SOLID_WRAP, 0));
+        // map color between thresholds
+        if (color > 0 and color < 60) {
+          SEGMENT.setPixelColorXY(x0 + i, y, SEGMENT.color_from_palette(map(color * 9, 9, 531, 0, 255), false, PALETTE_SOLID_WRAP, 0));
+        } else {
+          SEGMENT.setPixelColorXY(x0 + i, y, SEGMENT.color_from_palette(0, false, PALETTE_SOLID_WRAP, 0));
+        }
       }
-      // show the 3 points, too
-      SEGMENT.setPixelColorXY(x1, y1, WHITE);
-      SEGMENT.setPixelColorXY(x2, y2, WHITE);
-      SEGMENT.setPixelColorXY(x3, y3, WHITE);
     }
   }
+  // show the 3 points, too
+  SEGMENT.setPixelColorXY(x1, y1, WHITE);
+  SEGMENT.setPixelColorXY(x2, y2, WHITE);
+  SEGMENT.setPixelColorXY(x3, y3, WHITE);
 
   return FRAMETIME;
 } // mode_2Dmetaballs()
@@ -5500,9 +5529,11 @@ uint16_t mode_2Dnoise(void) {                  // By Andrew Tuline
 
   const unsigned scale  = SEGMENT.intensity+2;
 
+  uint8_t noiseRow[32]; // noise is calculated in batches of 32 pixels
   for (int y = 0; y < rows; y++) {
     for (int x = 0; x < cols; x++) {
-      uint8_t pixelHue8 = perlin8(x * scale, y * scale, strip.now / (16 - SEGMENT.speed/16));
+      if ((x & 31) == 0) perlin8Row(noiseRow, MIN(32, cols - x), x * scale, scale, y * scale, strip.now / (16 - SEGMENT.speed/16));
+      uint8_t pixelHue8 = noiseRow[x & 31];
       SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, pixelHue8));
     }
   }
@@ -5685,14 +5716,11 @@ uint16_t mode_2DSunradiation(void) {                   // By: ldirko https://edi
   }
 
   unsigned long t = strip.now / 4;
-  unsigned index = 0;
   uint8_t someVal = SEGMENT.speed/4;             // Was 25.
-  for (int j = 0; j < (rows + 2); j++) {
-    for (int i = 0; i < (cols + 2); i++) {
-      //byte col = (inoise8_raw(i * someVal, j * someVal, t)) / 2;
-      byte col = ((int16_t)perlin8(i * someVal, j * someVal, t) - 0x7F) / 3;
-      bump[index++] = col;
-    }
+  //byte col = (inoise8_raw(i * someVal, j * someVal, t)) / 2;
+  perlin8Grid(bump, cols + 2, rows + 2, 0, someVal, 0, someVal, t); // noise at (i * someVal, j * someVal, t)
+  for (int index = 0; index < (cols + 2) * (rows + 2); index++) {
+    bump[index] = ((int16_t)bump[index] - 0x7F) / 3;
   }
 
   int yindex = cols + 3;
@@ -6226,10 +6254,8 @@ uint16_t mode_2Dplasmarotozoom() {
   // plasma
   for (int j = 0; j < rows; j++) {
     int index = j*cols;
-    for (int i = 0; i < cols; i++) {
-      if (SEGMENT.check1) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
-      else                plasma[index+i] = inoise8(i * 40, j * 40, ms);
-    }
+    if (SEGMENT.check1) for (int i = 0; i < cols; i++) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
+    else                perlin8Row(&plasma[index], cols, 0, 40, j * 40, ms);
   }
 
   // rotozoom
@@ -7565,11 +7591,12 @@ uint16_t mode_2Dsoap() {
   if (SEGENV.call == 0) for (int i = 0; i < 3; i++) noisecoord[i] = hw_random(); // init
   else                  for (int i = 0; i < 3; i++) noisecoord[i] += mov;
 
-  for (int i = 0; i < cols; i++) {
-    int32_t ioffset = scale32_x * (i - cols / 2);
-    for (int j = 0; j < rows; j++) {
-      int32_t joffset = scale32_y * (j - rows / 2);
-      uint8_t data = perlin16(noisecoord[0] + ioffset, noisecoord[1] + joffset, noisecoord[2]) >> 8;
+  uint16_t noiseRow[32]; // noise is calculated in batches of 32 pixels
+  for (int j = 0; j < rows; j++) {
+    int32_t joffset = scale32_y * (j - rows / 2);
+    for (int i = 0; i < cols; i++) {
+      if ((i & 31) == 0) perlin16Row(noiseRow, MIN(32, cols - i), noisecoord[0] + scale32_x * (i - cols / 2), scale32_x, noisecoord[1] + joffset, noisecoord[2]);
+      uint8_t data = noiseRow[i & 31] >> 8;
       noise3d[XY(i,j)] = scale8(noise3d[XY(i,j)], smoothness) + scale8(data, 255 - smoothness);
     }
   }
@@ -7601,45 +7628,20 @@ uint16_t mode_2Doctopus() {
 
   const int cols = SEG_W;
   const int rows = SEG_H;
-  const auto XY = [&](int x, int y) { return (x%cols) + (y%rows) * cols; };
   const uint8_t mapp = 180 / MAX(cols,rows);
+  const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
+  const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
 
-  typedef struct {
-    uint8_t angle;
-    uint8_t radius;
-  } map_t;
-
-  const size_t dataSize = SEGMENT.width() * SEGMENT.height() * sizeof(map_t); // prevent reallocation if mirrored or grouped
-  if (!SEGENV.allocateData(dataSize + 2)) return mode_static(); //allocation failed
-
-  map_t *rMap = reinterpret_cast<map_t*>(SEGENV.data);
-  uint8_t *offsX = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize);
-  uint8_t *offsY = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize + 1);
-
-  // re-init if SEGMENT dimensions or offset changed
-  if (SEGENV.call == 0 || SEGENV.aux0 != cols || SEGENV.aux1 != rows || SEGMENT.custom1 != *offsX || SEGMENT.custom2 != *offsY) {
-    SEGENV.step = 0; // t
-    SEGENV.aux0 = cols;
-    SEGENV.aux1 = rows;
-    *offsX = SEGMENT.custom1;
-    *offsY = SEGMENT.custom2;
-    const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
-    const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
-    for (int x = 0; x < cols; x++) {
-      for (int y = 0; y < rows; y++) {
-        int dx = (x - C_X);
-        int dy = (y - C_Y);
-        rMap[XY(x, y)].angle  = int(40.7436f * atan2_t(dy, dx));  // avoid 128*atan2()/PI
-        rMap[XY(x, y)].radius = sqrtf(dx * dx + dy * dy) * mapp; //thanks Sutaburosu
-      }
-    }
-  }
+  // angle/radius map is shared with other radial effects and only recalculated if dimensions or offset change
+  const polarmap_t *rMap = SEGMENT.getPolarMap(C_X, C_Y, mapp);
+  if (!rMap) return mode_static(); //allocation failed
 
   SEGENV.step += SEGMENT.speed / 32 + 1;  // 1-4 range
-  for (int x = 0; x < cols; x++) {
-    for (int y = 0; y < rows; y++) {
-      byte angle = rMap[XY(x,y)].angle;
-      byte radius = rMap[XY(x,y)].radius;
+  for (int y = 0; y < rows; y++) {
+    for (int x = 0; x < cols; x++) {
+      byte angle = rMap->angle;
+      byte radius = rMap->radius;
+      rMap++;
       //CRGB c = CHSV(SEGENV.step / 2 - radius, 255, sin8_t(sin8_t((angle * 4 - radius) / 4 + SEGENV.step) + radius - SEGENV.step * 2 + angle * (SEGMENT.custom3/3+1)));
       unsigned intensity = sin8_t(sin8_t((angle * 4 - radius) / 4 + SEGENV.step/2) + radius - SEGENV.step + angle * (SEGMENT.custom3/4+1));
       intensity = map((intensity*intensity) & 0xFFFF, 0, 65535, 0, 255); // add a bit of non-linearity for cleaner display
@@ -7952,7 +7954,7 @@ uint16_t mode_particlevolcano(void) {
   uint32_t i = 0;
 
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, NUMBEROFSOURCES)) // init, no additional data needed
+    if (!initParticleSystem2D(PartSys, NUMBEROFSOURCES, 0, false, false, true)) // init with collisions, no additional data needed
       return mode_static(); // allocation failed or not 2D
 
     PartSys->setBounceY(true);
@@ -8128,7 +8130,7 @@ uint16_t mode_particlepit(void) {
   ParticleSystem2D *PartSys = nullptr;
 
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, 0, 0, true, false)) // init
+    if (!initParticleSystem2D(PartSys, 0, 0, true, false, true)) // init with collisions
       return mode_static(); // allocation failed or not 2D
     PartSys->setKillOutOfBounds(true);
     PartSys->setGravity(); // enable with default gravity
@@ -8200,7 +8202,7 @@ uint16_t mode_particlewaterfall(void) {
   uint32_t i = 0;
 
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, 12)) // init, request 12 sources, no additional data needed
+    if (!initParticleSystem2D(PartSys, 12, 0, false, false, true)) // init with collisions, request 12 sources, no additional data needed
       return mode_static(); // allocation failed or not 2D
 
     PartSys->setGravity();  // enable with default gforce
@@ -8271,7 +8273,7 @@ uint16_t mode_particlebox(void) {
   uint32_t i;
 
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, 1)) // init
+    if (!initParticleSystem2D(PartSys, 1, 0, false, false, true)) // init with collisions
       return mode_static(); // allocation failed or not 2D
     PartSys->setBounceX(true);
     PartSys->setBounceY(true);
@@ -8352,7 +8354,7 @@ uint16_t mode_particleperlin(void) {
   uint32_t i;
 
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, 1, 0, true)) // init with 1 source and advanced properties
+    if (!initParticleSystem2D(PartSys, 1, 0, true, false, true)) // init with 1 source, advanced properties and collisions
       return mode_static(); // allocation failed or not 2D
 
     PartSys->setKillOutOfBounds(true); // should never happen, but lets make sure there are no stray particles
@@ -8417,7 +8419,7 @@ uint16_t mode_particleimpact(void) {
   meteorsettings.asByte = 0b00101000; // PS settings for meteors: bounceY and gravity enabled
 
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, NUMBEROFSOURCES)) // init, no additional data needed
+    if (!initParticleSystem2D(PartSys, NUMBEROFSOURCES, 0, false, false, true)) // init with collisions, no additional data needed
       return mode_static(); // allocation failed or not 2D
     PartSys->setKillOutOfBounds(true);
     PartSys->setGravity(); // enable default gravity
@@ -8527,7 +8529,7 @@ uint16_t mode_particleattractor(void) {
   attractorFlags.asByte = 0; // no flags set
   PSparticle *attractor; // particle pointer to the attractor
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, 1, sizeof(PSparticle), true)) // init using 1 source and advanced particle settings
+    if (!initParticleSystem2D(PartSys, 1, sizeof(PSparticle), true, false, true)) // init using 1 source, advanced particle settings and collisions
       return mode_static(); // allocation failed or not 2D
     PartSys->sources[0].source.hue = hw_random16();
     PartSys->sources[0].source.vx = -7; // will collied with wall and get random bounce direction
@@ -8620,7 +8622,7 @@ uint16_t mode_particlespray(void) {
   const uint8_t hardness = 200; // collision hardness is fixed
 
   if (SEGMENT.call == 0) { // initialization
-    if (!initParticleSystem2D(PartSys, 1)) // init, no additional data needed
+    if (!initParticleSystem2D(PartSys, 1, 0, false, false, true)) // init with collisions, no additional data needed
       return mode_static(); // allocation failed or not 2D
     PartSys->setKillOutOfBounds(true); // out of bounds particles dont return (except on top, taken care of by gravity setting)
     PartSys->setBounceY(true);
@@ -8930,7 +8932,7 @@ uint16_t mode_particleblobs(void) {
   ParticleSystem2D *PartSys = nullptr;
 
   if (SEGMENT.call == 0) {
-    if (!initParticleSystem2D(PartSys, 0, 0, true, true)) //init, no additional bytes, advanced size & size control
+    if (!initParticleSystem2D(PartSys, 0, 0, true, true, true)) //init, no additional bytes, advanced size & size control, collisions
       return mode_static(); // allocation failed or not 2D
     PartSys->setBounceX(true);
     PartSys->setBounceY(true);
@@ -413,9 +413,15 @@ typedef enum mapping1D2D {
   M12_sPinwheel = 4
 } mapping1D2D_t;
 
+// polar coordinates of a pixel relative to a center (used by radial 2D effects)
+typedef struct PolarCoord {
+  uint8_t angle;   // 0-255 covers full circle (0 = positive X axis)
+  uint8_t radius;  // distance from center multiplied by scale (clamped to 255)
+} polarmap_t;
+
 class WS2812FX;
 
-// segment, 76 bytes
+// segment, 84 bytes
 class Segment {
   public:
     uint32_t colors[NUM_COLORS];
@@ -471,6 +477,7 @@ class Segment {
 
   private:
     uint32_t *pixels;                 // pixel data
+    mutable uint32_t _prngState;      // state of per-segment pseudo random number stream (xorshift32)
     unsigned _dataLen;
     uint8_t  _default_palette;        // palette number that gets assigned to pal0
     union {
@@ -530,12 +537,20 @@ class Segment {
       }
     } *_t;
 
+    // polar map cache (10 bytes + 2 bytes per virtual pixel), survives effect changes
+    struct PolarMap {
+      uint16_t cols, rows;  // virtual dimensions the map was built for
+      int16_t  cX, cY;      // center (in virtual pixels)
+      uint16_t scale;       // radius multiplier
+      inline size_t size() const { return sizeof(PolarMap) + cols * rows * sizeof(polarmap_t); }
+      inline polarmap_t *map()   { return reinterpret_cast<polarmap_t*>(this + 1); }
+    } *_polarMap;
+
   protected:
 
     inline static unsigned getUsedSegmentData()            { return Segment::_usedSegmentData; }
     inline static void     addUsedSegmentData(int len)     { Segment::_usedSegmentData += len; }
 
-    inline uint32_t *getPixels() const                              { return pixels; }
     inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; }
     inline uint32_t getPixelColorRaw(unsigned i) const              { return pixels[i]; };
   #ifndef WLED_DISABLE_2D
@@ -593,10 +608,12 @@ class Segment {
     , aux0(0)
     , aux1(0)
     , data(nullptr)
+    , _prngState(hw_random() | 1) // state must not be 0
     , _dataLen(0)
     , _default_palette(6)
     , _capabilities(0)
     , _t(nullptr)
+    , _polarMap(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
       // allocate render buffer (always entire segment)
@@ -622,6 +639,7 @@ class Segment {
       #endif
       clearName();
       deallocateData();
+      deallocatePolarMap();
       d_free(pixels);
     }
 
@@ -629,7 +647,7 @@ class Segment {
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0); }
+    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0) + (_polarMap?_polarMap->size():0); }
 #endif
 
     inline bool     getOption(uint8_t n)   const { return ((options >> n) & 0x01); }
@@ -669,8 +687,15 @@ class Segment {
 
     // runtime data functions
     inline uint16_t dataSize() const { return _dataLen; }
+    inline size_t   availableDataSize() const { // largest data buffer this segment can get within MAX_SEGMENT_DATA (own buffer and polar map cache can be reused)
+      size_t used = getUsedSegmentData(), own = _dataLen + (_polarMap ? _polarMap->size() : 0);
+      used = used > own ? used - own : 0;
+      return used < MAX_SEGMENT_DATA ? MAX_SEGMENT_DATA - used : 0;
+    }
+    inline uint32_t *getPixels() const { return pixels; } // raw pixel buffer (vWidth() x vHeight(), row-major), used by particle system renderers
     bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
     void deallocateData();          // deallocates (frees) effect data buffer from heap
+    void deallocatePolarMap();      // deallocates (frees) cached polar map from heap
     /**
       * Flags that before the next effect is calculated,
       * the internal segment state should be reset.
@@ -679,6 +704,20 @@ class Segment {
       */
     inline Segment &markForReset() { reset = true; return *this; }  // setOption(SEG_OPTION_RESET, true)
 
+    // per-segment pseudo random number stream (xorshift32), seeded from hardware RNG when effect is (re)started
+    // much faster than hw_random() in effect hot loops and reproducible if seeded explicitly (testing, multi-controller sync)
+    // return values in the range lowerlimit to upperlimit-1, no limit check is done for 8bit and 16bit functions (same as hw_random)
+    inline void     setRandomSeed(uint32_t seed) const { _prngState = seed ? seed : 0x9E3779B9U; }
+    inline uint32_t getRandomSeed() const              { return _prngState; }
+    inline uint32_t prng() const                       { uint32_t x = _prngState; x ^= x << 13; x ^= x >> 17; x ^= x << 5; return _prngState = x; }
+    inline uint16_t prng16() const                     { return prng() >> 16; } // upper bits have best quality
+    inline uint16_t prng16(uint32_t upperlimit) const  { return (prng16() * upperlimit) >> 16; } // input range 0-65535 (uint16_t)
+    inline int16_t  prng16(int32_t lowerlimit, int32_t upperlimit) const { int32_t range = upperlimit - lowerlimit; return lowerlimit + prng16(range); } // signed limits, use int16_t ranges
+    inline uint8_t  prng8() const                      { return prng() >> 24; }
+    inline uint8_t  prng8(uint32_t upperlimit) const   { return (prng8() * upperlimit) >> 8; } // input range 0-255
+    inline uint8_t  prng8(uint32_t lowerlimit, uint32_t upperlimit) const { uint32_t range = upperlimit - lowerlimit; return lowerlimit + prng8(range); } // input range 0-255
+    void prngFill(uint8_t *buf, size_t len) const;     // fills buffer with random bytes (4 bytes per PRNG step)
+
     void startTransition(uint16_t dur, bool segmentCopy = true);    // transition has to start before actual segment values change
     uint8_t  currentCCT() const; // current segment's CCT (blended while in transition)
     uint8_t  currentBri() const; // current segment's opacity/brightness (blended while in transition)
@@ -757,6 +796,7 @@ class Segment {
     void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t c, bool soft = false) const;
     void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color, uint32_t col2 = 0, int8_t rotate = 0) const;
     void wu_pixel(uint32_t x, uint32_t y, CRGB c) const;
+    const polarmap_t *getPolarMap(int cX, int cY, uint16_t scale); // cached angle/radius map for radial effects
     inline void drawCircle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB c, bool soft = false) const { drawCircle(cx, cy, radius, RGBW32(c.r,c.g,c.b,0), soft); }
     inline void fillCircle(uint16_t cx, uint16_t cy, uint8_t radius, CRGB c, bool soft = false) const { fillCircle(cx, cy, radius, RGBW32(c.r,c.g,c.b,0), soft); }
     inline void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, CRGB c, bool soft = false) const { drawLine(x0, y0, x1, y1, RGBW32(c.r,c.g,c.b,0), soft); } // automatic inline
@@ -798,6 +838,7 @@ class Segment {
     inline void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, uint32_t color, uint32_t = 0, int8_t = 0) {}
     inline void drawCharacter(unsigned char chr, int16_t x, int16_t y, uint8_t w, uint8_t h, CRGB c, CRGB c2, int8_t rotate = 0) {}
     inline void wu_pixel(uint32_t x, uint32_t y, CRGB c) {}
+    inline const polarmap_t *getPolarMap(int cX, int cY, uint16_t scale) { return nullptr; }
   #endif
   friend class WS2812FX;
 };
@@ -889,6 +930,7 @@ class WS2812FX {
       waitForIt();                                // wait until frame is over (service() has finished or time for 1 frame has passed)
 
     void setRealtimePixelColor(unsigned i, uint32_t c);
+    uint32_t *getRealtimePixels(unsigned &len);   // buffer that realtime data is written to (main segment or whole strip) and its length
     inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) _pixels[n] = c; }  // paints absolute strip pixel with index n and color c
     inline void resetTimebase()                               { timebase = 0UL - millis(); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const
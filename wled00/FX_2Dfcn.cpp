@@ -637,4 +637,62 @@ void Segment::wu_pixel(uint32_t x, uint32_t y, CRGB c) const {      //awesome wu
 }
 #undef WU_WEIGHT
 
+// returns angle & radius of each virtual pixel relative to center (cX,cY), indexed as x + y*vWidth()
+// radius is distance from center multiplied by scale, angle 0-255 covers full circle
+// map is cached (outside effect data) so it survives effect changes; it is only rebuilt if
+// dimensions, center or scale change and is released if effect data needs the memory
+// returns nullptr if there is not enough memory
+const polarmap_t *Segment::getPolarMap(int cX, int cY, uint16_t scale) {
+  if (!isActive()) return nullptr; // not active
+  const unsigned cols = vWidth();
+  const unsigned rows = vHeight();
+  if (_polarMap && _polarMap->cols == cols && _polarMap->rows == rows &&
+      _polarMap->cX == cX && _polarMap->cY == cY && _polarMap->scale == scale) return _polarMap->map(); // cache hit
+
+  const size_t len = sizeof(PolarMap) + cols * rows * sizeof(polarmap_t);
+  const size_t oldLen = _polarMap ? _polarMap->size() : 0;
+  if (len != oldLen) {
+    if (Segment::getUsedSegmentData() + len - oldLen > MAX_SEGMENT_DATA) {
+      DEBUG_PRINTF_P(PSTR("!!! Not enough RAM for polar map: %d/%d !!!\n"), len, Segment::getUsedSegmentData());
+      deallocatePolarMap();
+      return nullptr;
+    }
+    PolarMap *newMap = static_cast<PolarMap*>(_polarMap ? d_realloc(_polarMap, len) : d_malloc(len));
+    if (!newMap) {
+      DEBUG_PRINTLN(F("!!! Polar map allocation failed. !!!"));
+      deallocatePolarMap(); // d_realloc() keeps old buffer on failure
+      return nullptr;
+    }
+    _polarMap = newMap;
+    Segment::addUsedSegmentData(int(len) - int(oldLen));
+  }
+  _polarMap->cols  = cols;
+  _polarMap->rows  = rows;
+  _polarMap->cX    = cX;
+  _polarMap->cY    = cY;
+  _polarMap->scale = scale;
+
+  // transcendental math is only done here, once per geometry change
+  polarmap_t *pMap = _polarMap->map();
+  int16_t dx[32], dy[32];
+  uint8_t angle[32];
+  for (int y = 0; y < int(rows); y++) {
+    for (int x = 0; x < int(cols); x += 32) { // 32 pixels of a row at a time
+      const unsigned n = MIN(32U, cols - x);
+      for (unsigned i = 0; i < n; i++) {
+        dx[i] = x + i - cX;
+        dy[i] = y - cY;
+      }
+      atan2Span(angle, dy, dx, n, MATH_EXACT); // 128*atan2()/PI, wraps into 0-255
+      for (unsigned i = 0; i < n; i++) {
+        const unsigned radius = sqrtf(float(dx[i] * dx[i] + dy[i] * dy[i])) * scale;
+        pMap->angle  = angle[i];
+        pMap->radius = MIN(radius, 255U);
+        pMap++;
+      }
+    }
+  }
+  return _polarMap->map();
+}
+
 #endif // WLED_DISABLE_2D
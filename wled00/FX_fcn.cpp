@@ -65,6 +65,7 @@ Segment::Segment(const Segment &orig) {
   data = nullptr;
   _dataLen = 0;
   pixels = nullptr;
+  _polarMap = nullptr; // polar map is a cache, it will be rebuilt on demand
   if (!stop) return;  // nothing to do if segment is inactive/invalid
   if (orig.name) { name = static_cast<char*>(d_malloc(strlen(orig.name)+1)); if (name) strcpy(name, orig.name); }
   if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
@@ -88,6 +89,7 @@ Segment::Segment(Segment &&orig) noexcept {
   orig.data = nullptr;
   orig._dataLen = 0;
   orig.pixels = nullptr;
+  orig._polarMap = nullptr;
 }
 
 // copy assignment
@@ -98,6 +100,7 @@ Segment& Segment::operator= (const Segment &orig) {
     if (name) { d_free(name); name = nullptr; }
     if (_t) stopTransition(); // also erases _t
     deallocateData();
+    deallocatePolarMap();
     d_free(pixels);
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
@@ -105,6 +108,7 @@ Segment& Segment::operator= (const Segment &orig) {
     data = nullptr;
     _dataLen = 0;
     pixels = nullptr;
+    _polarMap = nullptr;
     if (!stop) return *this;  // nothing to do if segment is inactive/invalid
     // copy source data
     if (orig.name) { name = static_cast<char*>(d_malloc(strlen(orig.name)+1)); if (name) strcpy(name, orig.name); }
@@ -129,6 +133,7 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     if (name) { d_free(name); name = nullptr; } // free old name
     if (_t) stopTransition(); // also erases _t
     deallocateData(); // free old runtime data
+    deallocatePolarMap(); // free old polar map
     d_free(pixels);   // free old pixel buffer
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
@@ -136,6 +141,7 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     orig.data = nullptr;
     orig._dataLen = 0;
     orig.pixels = nullptr;
+    orig._polarMap = nullptr;
     orig._t = nullptr; // old segment cannot be in transition
   }
   return *this;
@@ -152,6 +158,7 @@ bool Segment::allocateData(size_t len) {
     return true;
   }
   //DEBUG_PRINTF_P(PSTR("--   Allocating data (%d): %p\n"), len, this);
+  if (_polarMap && Segment::getUsedSegmentData() + len - _dataLen > MAX_SEGMENT_DATA) deallocatePolarMap(); // effect data takes precedence over cached polar map
   if (Segment::getUsedSegmentData() + len - _dataLen > MAX_SEGMENT_DATA) {
     // not enough memory
     DEBUG_PRINTF_P(PSTR("!!! Not enough RAM: %d/%d !!!\n"), len, Segment::getUsedSegmentData());
@@ -188,6 +195,28 @@ void Segment::deallocateData() {
   _dataLen = 0;
 }
 
+void Segment::deallocatePolarMap() {
+  if (!_polarMap) return;
+  size_t len = _polarMap->size();
+  Segment::addUsedSegmentData(len <= Segment::getUsedSegmentData() ? -int(len) : -Segment::getUsedSegmentData());
+  d_free(_polarMap);
+  _polarMap = nullptr;
+}
+
+// fills buffer with bytes from segment's random stream
+void Segment::prngFill(uint8_t *buf, size_t len) const {
+  while (len >= 4) {
+    uint32_t r = prng();
+    memcpy(buf, &r, 4);
+    buf += 4;
+    len -= 4;
+  }
+  if (len) {
+    uint32_t r = prng();
+    memcpy(buf, &r, len);
+  }
+}
+
 /**
   * If reset of this segment was requested, clears runtime
   * settings of this segment.
@@ -201,6 +230,7 @@ void Segment::resetIfRequired() {
   if (data && _dataLen > 0) memset(data, 0, _dataLen);  // prevent heap fragmentation (just erase buffer instead of deallocateData())
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
   next_time = 0; step = 0; call = 0; aux0 = 0; aux1 = 0;
+  setRandomSeed(hw_random()); // new random stream for each effect (re)start
   reset = false;
   #ifdef WLED_ENABLE_GIF
   endImagePlayback(this);
@@ -422,6 +452,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   markForReset();
   startTransition(strip.getTransition()); // start transition prior to change (if segment is deactivated (start>stop) no transition will happen)
   stateChanged = true; // send UDP/WS broadcast
+  deallocatePolarMap(); // cached polar map no longer matches segment dimensions
 
   // apply change immediately
   if (i2 <= i1) { //disable segment
@@ -1656,6 +1687,17 @@ void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   }
 }
 
+// same target as setRealtimePixelColor(), for writing a span of pixels directly
+uint32_t *WS2812FX::getRealtimePixels(unsigned &len) {
+  if (useMainSegmentOnly) {
+    const Segment &seg = getMainSegment();
+    len = seg.isActive() ? seg.length() : 0;
+    return len ? seg.getPixels() : nullptr;
+  }
+  len = getLengthTotal();
+  return _pixels;
+}
+
 // reset all segments
 void WS2812FX::restartRuntime() {
   suspend();
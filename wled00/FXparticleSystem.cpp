@@ -17,16 +17,17 @@
 // local shared functions (used both in 1D and 2D system)
 static int32_t calcForce_dv(const int8_t force, uint8_t &counter);
 static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap); // returns false if out of bounds by more than particleradius
-static void fast_color_add(CRGB &c1, const CRGB &c2, uint8_t scale = 255); // fast and accurate color adding with scaling (scales c2 before adding)
-static void fast_color_scale(CRGB &c, const uint8_t scale); // fast scaling function using 32bit variable and pointer. note: keep 'scale' within 0-255
-//static CRGB *allocateCRGBbuffer(uint32_t length);
+static void fast_color_add(uint32_t &c1, const uint32_t c2, uint8_t scale = 255); // fast and accurate color adding with scaling (scales c2 before adding)
+static void fast_color_scale(uint32_t &c, const uint8_t scale); // fast in place scaling function. note: keep 'scale' within 0-255
+static uint32_t desaturate(const uint32_t rgb, const uint8_t sat); // reduce saturation (HSV) to sat, never increases it
 #endif
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
-ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t numberofparticles, uint32_t numberofsources, bool isadvanced, bool sizecontrol) {
+ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t numberofparticles, uint32_t numberofsources, bool isadvanced, bool sizecontrol, uint32_t collisiontable) {
   PSPRINTLN("\n ParticleSystem2D constructor");
   numSources = numberofsources; // number of sources allocated in init
   numParticles = numberofparticles; // number of particles allocated in init
+  collisionTableSize = collisiontable; // collision grid allocated in init
   usedParticles = numParticles; // use all particles by default
   advPartProps = nullptr; //make sure we start out with null pointers (just in case memory was not cleared)
   advPartSize = nullptr;
@@ -39,7 +40,8 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
   emitIndex = 0;
-  collisionStartIdx = 0;
+  if (spriteCache)
+    memset(spriteCache, 0, sizeof(PSspriteProfile) * PS_SPRITECACHE_SIZE); // mark all cached profiles unused
 
   //initialize some default non-zero values most FX use
   for (uint32_t i = 0; i < numParticles; i++) {
@@ -188,14 +190,14 @@ int32_t ParticleSystem2D::sprayEmit(const PSsource &emitter) {
       emitIndex = 0;
     if (particles[emitIndex].ttl == 0) { // find a dead particle
       success = true;
-      particles[emitIndex].vx = emitter.vx + hw_random16(emitter.var << 1) - emitter.var; // random(-var, var)
-      particles[emitIndex].vy = emitter.vy + hw_random16(emitter.var << 1) - emitter.var; // random(-var, var)
+      particles[emitIndex].vx = emitter.vx + SEGMENT.prng16(emitter.var << 1) - emitter.var; // random(-var, var)
+      particles[emitIndex].vy = emitter.vy + SEGMENT.prng16(emitter.var << 1) - emitter.var; // random(-var, var)
       particles[emitIndex].x = emitter.source.x;
       particles[emitIndex].y = emitter.source.y;
       particles[emitIndex].hue = emitter.source.hue;
       particles[emitIndex].sat = emitter.source.sat;
       particleFlags[emitIndex].collide = emitter.sourceFlags.collide;
-      particles[emitIndex].ttl = hw_random16(emitter.minLife, emitter.maxLife);
+      particles[emitIndex].ttl = SEGMENT.prng16(emitter.minLife, emitter.maxLife);
       if (advPartProps)
         advPartProps[emitIndex].size = emitter.size;
       break;
@@ -385,6 +387,44 @@ void ParticleSystem2D::getParticleXYsize(PSadvancedParticle *advprops, PSsizeCon
   ysize = min((size + deviation), (int32_t)255);;
 }
 
+// get the brightness profile of an advanced size particle along one axis, size is 0-255, offset is the sub-pixel position 0-63
+// the profile replicates the blur passes formerly applied to each particle: two pixels with linear brightness distribution are blurred up to four times, widening by one pixel per side in each pass
+// profiles are cached by size and sub-pixel position (quantized to 16 steps), a particle sprite is the product of its x and y profile
+const uint16_t *ParticleSystem2D::getSpriteProfile(const uint32_t size, const uint32_t offset) {
+  uint32_t subpixel = offset >> 2; // 16 sub-pixel steps
+  uint16_t key = ((size << 4) | subpixel) + 1; // +1 as 0 marks an unused entry
+  PSspriteProfile &entry = spriteCache[(size * 5 + subpixel) & (PS_SPRITECACHE_SIZE - 1)];
+  if (entry.key == key)
+    return entry.profile;
+
+  uint32_t pos = (subpixel << 2) + 2; // center of the quantization step
+  uint32_t profile[10] = {0};
+  profile[4] = gamma8inv(((PS_P_RADIUS - pos) * 255) >> PS_P_RADIUS_SHIFT); // brightness of a 2x2 particle, see renderParticle()
+  profile[5] = gamma8inv((pos * 255) >> PS_P_RADIUS_SHIFT);
+  uint32_t blursize = size;
+  uint32_t passes = size / 64 + 1; // number of blur passes depends on size, four passes max
+  uint32_t bitshift = 0;
+  for (uint32_t i = 0; i < passes; i++) {
+    if (i == 2) // for the last two passes, use higher amount of blur (results in a nicer brightness gradient with soft edges)
+      bitshift = 1;
+    uint32_t seep = (uint8_t)((blursize << bitshift) >> 1);
+    uint32_t carryover = 0;
+    for (uint32_t x = 3 - i; x < 7 + i; x++) { // blur area grows by one pixel on each side per pass
+      uint32_t seeppart = (profile[x] * seep) >> 8;
+      if (x > 0) {
+        profile[x - 1] += seeppart; // note: not limited to 255, saturation is applied to the sprite (product of profiles)
+        profile[x] += carryover;
+      }
+      carryover = seeppart;
+    }
+    blursize = blursize > 64 ? blursize - 64 : 0;
+  }
+  for (uint32_t i = 0; i < 10; i++)
+    entry.profile[i] = profile[i];
+  entry.key = key;
+  return entry.profile;
+}
+
 // function to bounce a particle from a wall using set parameters (wallHardness and wallRoughness)
 void ParticleSystem2D::bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition) {
   incomingspeed = -incomingspeed;
@@ -397,7 +437,7 @@ void ParticleSystem2D::bounce(int8_t &incomingspeed, int8_t &parallelspeed, int3
     int32_t incomingspeed_abs = abs((int32_t)incomingspeed);
     int32_t totalspeed = incomingspeed_abs + abs((int32_t)parallelspeed);
     // transfer an amount of incomingspeed speed to parallel speed
-    int32_t donatespeed = ((hw_random16(incomingspeed_abs << 1) - incomingspeed_abs) * (int32_t)wallRoughness) / (int32_t)255; // take random portion of + or - perpendicular speed, scaled by roughness
+    int32_t donatespeed = ((SEGMENT.prng16(incomingspeed_abs << 1) - incomingspeed_abs) * (int32_t)wallRoughness) / (int32_t)255; // take random portion of + or - perpendicular speed, scaled by roughness
     parallelspeed = limitSpeed((int32_t)parallelspeed + donatespeed);
     // give the remainder of the speed to perpendicular speed
     donatespeed = int8_t(totalspeed - abs(parallelspeed)); // keep total speed the same
@@ -558,13 +598,19 @@ void ParticleSystem2D::pointAttractor(const uint32_t particleindex, PSparticle &
 // warning: do not render out of bounds particles or system will crash! rendering does not check if particle is out of bounds
 // firemode is only used for PS Fire FX
 void ParticleSystem2D::render() {
-  CRGB baseRGB;
+  uint32_t baseRGB;
   uint32_t brightness; // particle brightness, fades if dying
   TBlendType blend = LINEARBLEND; // default color rendering: wrap palette
-  if (particlesettings.colorByAge) {
+  if (particlesettings.colorByAge || fireIntesity) {
     blend = LINEARBLEND_NOWRAP;
   }
+  #ifndef ESP8266
+  // palette colors are looked up once per frame and color index (many particles share a color), entries are filled on first use
+  uint32_t paletteCache[256]; // note: 1k of stack is too much for ESP8266
+  uint32_t paletteCached[8] = {0}; // one bit per valid entry
+  #endif
 
+  framebuffer = SEGMENT.getPixels(); // render directly to the segment (segment buffer uses the same layout: vWidth() x vHeight(), y = 0 is the top row)
   if (motionBlur) { // motion-blurring active
     for (int32_t y = 0; y <= maxYpixel; y++) {
       int index = y * (maxXpixel + 1);
@@ -575,7 +621,7 @@ void ParticleSystem2D::render() {
     }
   }
   else { // no blurring: clear buffer
-    memset(framebuffer, 0, (maxXpixel+1) * (maxYpixel+1) * sizeof(CRGB));
+    memset(framebuffer, 0, (maxXpixel+1) * (maxYpixel+1) * sizeof(uint32_t));
   }
 
   // go over particles and render them to the buffer
@@ -583,23 +629,27 @@ void ParticleSystem2D::render() {
     if (particles[i].ttl == 0 || particleFlags[i].outofbounds)
       continue;
     // generate RGB values for particle
-    if (fireIntesity) { // fire mode
+    uint32_t colorindex;
+    if (fireIntesity) { // fire mode: color depends on brightness
       brightness = (uint32_t)particles[i].ttl * (3 + (fireIntesity >> 5)) + 5;
       brightness = min(brightness, (uint32_t)255);
-      baseRGB = ColorFromPaletteWLED(SEGPALETTE, brightness, 255, LINEARBLEND_NOWRAP);
+      colorindex = brightness;
     }
     else {
       brightness = min((particles[i].ttl << 1), (int)255);
-      baseRGB = ColorFromPaletteWLED(SEGPALETTE, particles[i].hue, 255, blend);
-      if (particles[i].sat < 255) {
-        CHSV32 baseHSV;
-        rgb2hsv((uint32_t((byte(baseRGB.r) << 16) | (byte(baseRGB.g) << 8) | (byte(baseRGB.b)))), baseHSV); // convert to HSV
-        baseHSV.s = min(baseHSV.s, particles[i].sat); // set the saturation but don't increase it
-        uint32_t tempcolor;
-        hsv2rgb(baseHSV, tempcolor); // convert back to RGB
-        baseRGB = (CRGB)tempcolor;
-      }
+      colorindex = particles[i].hue;
+    }
+    #ifndef ESP8266
+    if (!(paletteCached[colorindex >> 5] & (1U << (colorindex & 31)))) {
+      paletteCache[colorindex] = ColorFromPaletteWLED(SEGPALETTE, colorindex, 255, blend);
+      paletteCached[colorindex >> 5] |= 1U << (colorindex & 31);
     }
+    baseRGB = paletteCache[colorindex];
+    #else
+    baseRGB = ColorFromPaletteWLED(SEGPALETTE, colorindex, 255, blend);
+    #endif
+    if (!fireIntesity && particles[i].sat < 255)
+      baseRGB = desaturate(baseRGB, particles[i].sat);
     brightness = gamma8(brightness); // apply gamma correction, used for gamma-inverted brightness distribution
     renderParticle(i, brightness, baseRGB, particlesettings.wrapX, particlesettings.wrapY);
   }
@@ -621,18 +671,10 @@ void ParticleSystem2D::render() {
   if (smearBlur) {
     blur2D(framebuffer, maxXpixel + 1, maxYpixel + 1, smearBlur, smearBlur);
   }
-
-  // transfer the framebuffer to the segment
-  for (int y = 0; y <= maxYpixel; y++) {
-    int index = y * (maxXpixel + 1); // current row index for 1D buffer
-    for (int x = 0; x <= maxXpixel; x++) {
-      SEGMENT.setPixelColorXY(x, y, framebuffer[index++]);
-    }
-  }
 }
 
 // calculate pixel positions and brightness distribution and render the particle to local buffer or global buffer
-__attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGB& color, const bool wrapX, const bool wrapY) {
+__attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint32_t particleindex, const uint8_t brightness, const uint32_t color, const bool wrapX, const bool wrapY) {
   uint32_t size = particlesize;
   if (advPartProps && advPartProps[particleindex].size > 0) // use advanced size properties (0 means use global size including single pixel rendering)
     size = advPartProps[particleindex].size;
@@ -687,46 +729,28 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
   pxlbrightness[3] = gamma8inv(pxlbrightness[3]);
 
   if (advPartProps && advPartProps[particleindex].size > 1) { //render particle to a bigger size
-    CRGB renderbuffer[100]; // 10x10 pixel buffer
-    memset(renderbuffer, 0, sizeof(renderbuffer)); // clear buffer
     //particle size to pixels: < 64 is 4x4, < 128 is 6x6, < 192 is 8x8, bigger is 10x10
-    //first, render the pixel to the center of the renderbuffer, then apply 2D blurring
-    fast_color_add(renderbuffer[4 + (4 * 10)], color, pxlbrightness[0]); // oCrder is: bottom left, bottom right, top right, top left
-    fast_color_add(renderbuffer[5 + (4 * 10)], color, pxlbrightness[1]);
-    fast_color_add(renderbuffer[5 + (5 * 10)], color, pxlbrightness[2]);
-    fast_color_add(renderbuffer[4 + (5 * 10)], color, pxlbrightness[3]);
-    uint32_t rendersize = 2; // initialize render size, minimum is 4x4 pixels, it is incremented int he loop below to start with 4
-    uint32_t offset = 4; // offset to zero coordinate to write/read data in renderbuffer (actually needs to be 3, is decremented in the loop below)
-    uint32_t maxsize = advPartProps[particleindex].size;
-    uint32_t xsize = maxsize;
-    uint32_t ysize = maxsize;
-    if (advPartSize) { // use advanced size control
-      if (advPartSize[particleindex].asymmetry > 0)
-        getParticleXYsize(&advPartProps[particleindex], &advPartSize[particleindex], xsize, ysize);
-      maxsize = (xsize > ysize) ? xsize : ysize; // choose the bigger of the two
-    }
-    maxsize = maxsize/64 + 1; // number of blur passes depends on maxsize, four passes max
-    uint32_t bitshift = 0;
-    for (uint32_t i = 0; i < maxsize; i++) {
-      if (i == 2) //for the last two passes, use higher amount of blur (results in a nicer brightness gradient with soft edges)
-        bitshift = 1;
-      rendersize += 2;
-      offset--;
-      blur2D(renderbuffer, rendersize, rendersize, xsize << bitshift, ysize << bitshift, offset, offset, true);
-      xsize = xsize > 64 ? xsize - 64 : 0;
-      ysize = ysize > 64 ? ysize - 64 : 0;
-    }
-
-    // calculate origin coordinates to render the particle to in the framebuffer
-    uint32_t xfb_orig = x - (rendersize>>1) + 1 - offset;
-    uint32_t yfb_orig = y - (rendersize>>1) + 1 - offset;
+    //the sprite is stamped from cached x and y brightness profiles, they replicate blurring the particle in a 10x10 renderbuffer (blurring is separable)
+    uint32_t xsize = advPartProps[particleindex].size;
+    uint32_t ysize = xsize;
+    if (advPartSize && advPartSize[particleindex].asymmetry > 0) // use advanced size control
+      getParticleXYsize(&advPartProps[particleindex], &advPartSize[particleindex], xsize, ysize);
+    const uint16_t *xprofile = getSpriteProfile(xsize, dx);
+    const uint16_t *yprofile = getSpriteProfile(ysize, dy);
+    uint32_t spritecolor = color;
+    fast_color_scale(spritecolor, gamma8inv(brightness)); // profiles are calculated at full brightness (gamma is a power law, so it can be applied separately)
+
+    // calculate origin coordinates to render the particle to in the framebuffer, x and y are the bottom left pixel of a 2x2 particle which is at index 4 in the profiles
+    uint32_t xfb_orig = x - 4;
+    uint32_t yfb_orig = y - 4;
     uint32_t xfb, yfb; // coordinates in frame buffer to write to note: by making this uint, only overflow has to be checked (spits a warning though)
 
     //note on y-axis flip: WLED has the y-axis defined from top to bottom, so y coordinates must be flipped. doing this in the buffer xfer clashes with 1D/2D combined rendering, which does not invert y
     //                     transferring the 1D buffer in inverted fashion will flip the x-axis of overlaid 2D FX, so the y-axis flip is done here so the buffer is flipped in y, giving correct results
 
-    // transfer particle renderbuffer to framebuffer
-    for (uint32_t xrb = offset; xrb < rendersize + offset; xrb++) {
+    // stamp particle sprite to framebuffer
+    for (uint32_t xrb = 0; xrb < 10; xrb++) {
+      if (xprofile[xrb] == 0) continue;
       xfb = xfb_orig + xrb;
       if (xfb > (uint32_t)maxXpixel) {
       if (wrapX) { // wrap x to the other side if required
@@ -739,7 +763,10 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
         continue;
       }
 
-      for (uint32_t yrb = offset; yrb < rendersize + offset; yrb++) {
+      for (uint32_t yrb = 0; yrb < 10; yrb++) {
+        uint32_t spritebrightness = ((uint32_t)xprofile[xrb] * yprofile[yrb] + 255) >> 8;
+        if (spritebrightness == 0) continue;
+        spritebrightness = min(spritebrightness, (uint32_t)255);
         yfb = yfb_orig + yrb;
         if (yfb > (uint32_t)maxYpixel) {
           if (wrapY) {// wrap y to the other side if required
@@ -751,7 +778,7 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
           else
           continue;
         }
-        fast_color_add(framebuffer[xfb + (maxYpixel - yfb) * (maxXpixel + 1)], renderbuffer[xrb + yrb * 10]);
+        fast_color_add(framebuffer[xfb + (maxYpixel - yfb) * (maxXpixel + 1)], spritecolor, spritebrightness);
       }
     }
     } else { // standard rendering (2x2 pixels)
@@ -792,68 +819,100 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
   }
 }
 
+// collision grid dimensions for a particle area of maxX x maxY subpixels: cells are square with a size of (1 << cellShift) subpixels,
+// cellShift is increased until the grid has no more than maxCells cells, returns the resulting cellShift
+static uint32_t getCollisionGrid(const int32_t maxX, const int32_t maxY, uint32_t cellShift, const uint32_t maxCells, uint32_t &cols, uint32_t &rows) {
+  cols = (maxX >> cellShift) + 1;
+  rows = (maxY >> cellShift) + 1;
+  while (cols * rows > maxCells) { // too many cells, double the cell size
+    cellShift++;
+    cols = (maxX >> cellShift) + 1;
+    rows = (maxY >> cellShift) + 1;
+  }
+  return cellShift;
+}
+
 // detect collisions in an array of particles and handle them
-// uses binning by dividing the frame into slices in x direction which is efficient if using gravity in y direction (but less efficient for FX that use forces in x direction)
-// for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
-// note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
+// uses a uniform grid as broadphase: particles are sorted into square cells using a counting sort (two passes over the particles, no per-cell limit)
+// cells are at least as large as the largest collision distance, so a particle can only collide with particles in its own cell or in one of the 8 adjacent cells
+// each cell is tested against itself and 4 of its neighbours (right, bottom left, bottom, bottom right), so every pair of adjacent cells is checked exactly once
 void ParticleSystem2D::handleCollisions() {
+  if (!collisionCells) return; // no grid reserved, effect did not request collisions in initParticleSystem2D()
+  if (advPartProps) //may be using individual particle size
+    setParticleSize(particlesize); // updates base particleHardRadius
   uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
+  uint32_t maxCollDist = collDistSq;
   collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
-  // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  constexpr int BIN_WIDTH = 6 * PS_P_RADIUS; // width of a bin in sub-pixels
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
-  if (advPartProps) //may be using individual particle size
-    overlap += 512; // add 2 * max radius (approximately)
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 2); // assume no more than half of the particles are in the same bin, do not bin small amounts of particles
-  uint32_t numBins = (maxX + (BIN_WIDTH - 1)) / BIN_WIDTH; // number of bins in x direction
-  uint16_t binIndices[maxBinParticles]; // creat array on stack for indices, 2kB max for 1024 particles (ESP32_MAXPARTICLES/2)
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint16_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
-
-  // fill the binIndices array for this bin
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * BIN_WIDTH - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + BIN_WIDTH + overlap; // note: last bin can be out of bounds, see above;
-
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // is alive
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if(particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
-      }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
-    }
+  if (advPartProps)
+    maxCollDist += 256; // add max of individual sizes (see below)
+  uint32_t cellShift = PS_P_RADIUS_SHIFT; // cell size is a power of 2, at least one pixel
+  while ((1U << cellShift) < maxCollDist) cellShift++;
+  uint32_t cols, rows;
+  cellShift = getCollisionGrid(maxX, maxY, cellShift, collisionTableSize - 1, cols, rows); // grid was reserved for the smallest cells, larger cells always fit
+  const uint32_t numCells = cols * rows;
+
+  // cell of a particle, uses the lookahead position as that is what is used for the distance check, out of frame positions are clamped to the border cells
+  const auto getCell = [&](uint32_t idx) {
+    int32_t cx = (particles[idx].x + particles[idx].vx) >> cellShift;
+    int32_t cy = (particles[idx].y + particles[idx].vy) >> cellShift;
+    cx = constrain(cx, 0, (int32_t)cols - 1);
+    cy = constrain(cy, 0, (int32_t)rows - 1);
+    return cx + cy * cols;
+  };
+  const auto isColliding = [&](uint32_t idx) { // note: checking flags is quite slow and usually these are set, so check ttl first
+    return particles[idx].ttl > 0 && particleFlags[idx].outofbounds == 0 && particleFlags[idx].collide;
+  };
+
+  uint16_t *cellStart = collisionCells; // start index of each cell
+  uint16_t *cellParticles = collisionCells + collisionTableSize; // particle indices sorted by cell
+  memset(cellStart, 0, (numCells + 1) * sizeof(uint16_t));
+
+  // counting sort: count particles per cell, accumulate to cell end indices, then fill cells from the back
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (isColliding(i)) cellStart[getCell(i)]++;
+  }
+  for (uint32_t c = 1; c <= numCells; c++) cellStart[c] += cellStart[c - 1]; // note: last entry stays at total count
+  for (uint32_t i = usedParticles; i-- > 0;) {
+    if (isColliding(i)) cellParticles[--cellStart[getCell(i)]] = i; // iterating backwards keeps particles sorted by index within a cell
+  }
 
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles in this bin and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (advPartProps) { //may be using individual particle size
-          setParticleSize(particlesize); // updates base particleHardRadius
-          collDistSq = (particleHardRadius << 1) + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
-          collDistSq = collDistSq * collDistSq; // square it for faster comparison
-        }
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
-        if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
-          int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
-          if (dy * dy < collDistSq) // particles are close
-            collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
+  // check a pair of particles and make them collide if they are in close proximity
+  const auto checkPair = [&](uint32_t idx_i, uint32_t idx_j) {
+    if (advPartProps) { //may be using individual particle size
+      collDistSq = (particleHardRadius << 1) + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
+      collDistSq = collDistSq * collDistSq; // square it for faster comparison
+    }
+    int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
+    if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+      int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
+      if (dy * dy < collDistSq) // particles are close
+        collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
+    }
+  };
+
+  for (uint32_t cy = 0; cy < rows; cy++) {
+    for (uint32_t cx = 0; cx < cols; cx++) {
+      uint32_t cell = cx + cy * cols;
+      uint32_t start = cellStart[cell];
+      uint32_t end = cellStart[cell + 1];
+      if (start == end) continue; // empty cell
+      for (uint32_t i = start; i < end; i++) { // particles within this cell
+        for (uint32_t j = i + 1; j < end; j++)
+          checkPair(cellParticles[i], cellParticles[j]);
+      }
+      // neighbouring cells: right, then bottom left, bottom and bottom right (in the next row)
+      int32_t nx[4] = {(int32_t)cx + 1, (int32_t)cx - 1, (int32_t)cx, (int32_t)cx + 1};
+      int32_t ny[4] = {(int32_t)cy, (int32_t)cy + 1, (int32_t)cy + 1, (int32_t)cy + 1};
+      for (uint32_t n = 0; n < 4; n++) {
+        if (nx[n] < 0 || nx[n] >= (int32_t)cols || ny[n] >= (int32_t)rows) continue;
+        uint32_t ncell = nx[n] + ny[n] * cols;
+        for (uint32_t i = start; i < end; i++) {
+          for (uint32_t j = cellStart[ncell]; j < cellStart[ncell + 1]; j++)
+            checkPair(cellParticles[i], cellParticles[j]);
         }
       }
     }
   }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
 
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
@@ -988,14 +1047,17 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
   particles = reinterpret_cast<PSparticle *>(this + 1); // pointer to particles
   particleFlags = reinterpret_cast<PSparticleFlags *>(particles + numParticles); // pointer to particle flags
   sources = reinterpret_cast<PSsource *>(particleFlags + numParticles); // pointer to source(s) at data+sizeof(ParticleSystem2D)
-  framebuffer = reinterpret_cast<CRGB *>(sources + numSources); // pointer to framebuffer
-  // align pointer after framebuffer
-  uintptr_t p = reinterpret_cast<uintptr_t>(framebuffer + (maxXpixel+1)*(maxYpixel+1));
-  p = (p + 3) & ~0x03; // align to 4-byte boundary
-  PSdataEnd = reinterpret_cast<uint8_t *>(p); // pointer to first available byte after the PS for FX additional data
+  PSdataEnd = reinterpret_cast<uint8_t *>(sources + numSources); // pointer to first available byte after the PS for FX additional data (numSources is a multiple of 4, so this is aligned)
+  collisionCells = nullptr;
+  if (collisionTableSize) {
+    collisionCells = reinterpret_cast<uint16_t *>(PSdataEnd);
+    PSdataEnd = reinterpret_cast<uint8_t *>(collisionCells + collisionTableSize + numParticles); // table size and numParticles are multiples of 4, so this is aligned
+  }
+  spriteCache = nullptr;
   if (isadvanced) {
     advPartProps = reinterpret_cast<PSadvancedParticle *>(PSdataEnd);
-    PSdataEnd = reinterpret_cast<uint8_t *>(advPartProps + numParticles);
+    spriteCache = reinterpret_cast<PSspriteProfile *>(advPartProps + numParticles); // numParticles is a multiple of 4, so this is aligned
+    PSdataEnd = reinterpret_cast<uint8_t *>(spriteCache + PS_SPRITECACHE_SIZE);
     if (sizecontrol) {
       advPartSize = reinterpret_cast<PSsizeControl *>(PSdataEnd);
       PSdataEnd = reinterpret_cast<uint8_t *>(advPartSize + numParticles);
@@ -1015,8 +1077,8 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
 // for speed, 1D array and 32bit variables are used, make sure to limit them to 8bit (0-255) or result is undefined
 // to blur a subset of the buffer, change the xsize/ysize and set xstart/ystart to the desired starting coordinates (default start is 0/0)
 // subset blurring only works on 10x10 buffer (single particle rendering), if other sizes are needed, buffer width must be passed as parameter
-void blur2D(CRGB *colorbuffer, uint32_t xsize, uint32_t ysize, uint32_t xblur, uint32_t yblur, uint32_t xstart, uint32_t ystart, bool isparticle) {
-  CRGB seeppart, carryover;
+void blur2D(uint32_t *colorbuffer, uint32_t xsize, uint32_t ysize, uint32_t xblur, uint32_t yblur, uint32_t xstart, uint32_t ystart, bool isparticle) {
+  uint32_t seeppart, carryover;
   uint32_t seep = xblur >> 1;
   uint32_t width = xsize; // width of the buffer, used to calculate the index of the pixel
 
@@ -1075,7 +1137,7 @@ uint32_t calculateNumberOfParticles2D(uint32_t const pixels, const bool isadvanc
 #else
   uint32_t particlelimit = ESP32_MAXPARTICLES; // maximum number of paticles allowed (based on two segments of 32x32 and 40k effect ram)
 #endif
-  numberofParticles = max((uint32_t)4, min(numberofParticles, particlelimit)); // limit to 4 - particlelimit
+  numberofParticles = max((uint32_t)PS_MINPARTICLES, min(numberofParticles, particlelimit)); // limit to PS_MINPARTICLES - particlelimit
   if (isadvanced) // advanced property array needs ram, reduce number of particles to use the same amount
     numberofParticles = (numberofParticles * sizeof(PSparticle)) / (sizeof(PSparticle) + sizeof(PSadvancedParticle));
   if (sizecontrol) // advanced property array needs ram, reduce number of particles
@@ -1102,28 +1164,42 @@ uint32_t calculateNumberOfSources2D(uint32_t pixels, uint32_t requestedsources)
   return numberofSources;
 }
 
-//allocate memory for particle system class, particles, sprays plus additional memory requested by FX //TODO: add percentofparticles like in 1D to reduce memory footprint of some FX?
-bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources, bool isadvanced, bool sizecontrol, uint32_t additionalbytes) {
-  PSPRINTLN("PS 2D alloc");
-  PSPRINTLN("numparticles:" + String(numparticles) + " numsources:" + String(numsources) + " additionalbytes:" + String(additionalbytes));
+// cell start entries needed for the collision grid of a cols x rows pixel segment: one per cell plus an end marker, rounded up to a multiple of 4 for alignment
+// the grid is sized for the smallest cells (one pixel, i.e. single pixel particles), bigger particles use fewer, larger cells
+uint32_t calculateCollisionTableSize2D(uint32_t cols, uint32_t rows) {
+  uint32_t gridcols, gridrows;
+  getCollisionGrid(cols * PS_P_RADIUS - 1, rows * PS_P_RADIUS - 1, PS_P_RADIUS_SHIFT, PS_MAX_COLLISION_CELLS, gridcols, gridrows);
+  return (gridcols * gridrows + 4) & ~0x03;
+}
+
+// memory required for particle system class, particles, sprays, collision grid plus additional memory requested by FX
+uint32_t calculateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources, bool isadvanced, bool sizecontrol, uint32_t additionalbytes, uint32_t collisiontable) {
   uint32_t requiredmemory = sizeof(ParticleSystem2D);
   // functions above make sure numparticles is a multiple of 4 bytes (to avoid alignment issues)
   requiredmemory += sizeof(PSparticleFlags) * numparticles;
   requiredmemory += sizeof(PSparticle) * numparticles;
   if (isadvanced)
-    requiredmemory += sizeof(PSadvancedParticle) * numparticles;
+    requiredmemory += sizeof(PSadvancedParticle) * numparticles + sizeof(PSspriteProfile) * PS_SPRITECACHE_SIZE;
   if (sizecontrol)
     requiredmemory += sizeof(PSsizeControl) * numparticles;
   requiredmemory += sizeof(PSsource) * numsources;
-  requiredmemory += sizeof(CRGB) * SEGMENT.virtualLength(); // virtualLength is witdh * height
+  if (collisiontable)
+    requiredmemory += sizeof(uint16_t) * (collisiontable + numparticles); // collision grid
   requiredmemory += additionalbytes + 3; // add 3 to ensure there is room for stuffing bytes
-  //requiredmemory = (requiredmemory + 3) & ~0x03; // align memory block to next 4-byte boundary
+  return requiredmemory;
+}
+
+//allocate memory for particle system class, particles, sprays plus additional memory requested by FX //TODO: add percentofparticles like in 1D to reduce memory footprint of some FX?
+bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources, bool isadvanced, bool sizecontrol, uint32_t additionalbytes, uint32_t collisiontable) {
+  PSPRINTLN("PS 2D alloc");
+  PSPRINTLN("numparticles:" + String(numparticles) + " numsources:" + String(numsources) + " additionalbytes:" + String(additionalbytes));
+  uint32_t requiredmemory = calculateParticleSystemMemory2D(numparticles, numsources, isadvanced, sizecontrol, additionalbytes, collisiontable);
   PSPRINTLN("mem alloc: " + String(requiredmemory));
-  return(SEGMENT.allocateData(requiredmemory));
+  return(SEGMENT.allocateData(requiredmemory)); // note: an existing (larger) buffer is reused, so switching between PS effects does not fragment the heap
 }
 
 // initialize Particle System, allocate additional bytes if needed (pointer to those bytes can be read from particle system class: PSdataEnd)
-bool initParticleSystem2D(ParticleSystem2D *&PartSys, uint32_t requestedsources, uint32_t additionalbytes, bool advanced, bool sizecontrol) {
+bool initParticleSystem2D(ParticleSystem2D *&PartSys, uint32_t requestedsources, uint32_t additionalbytes, bool advanced, bool sizecontrol, bool collisions) {
   PSPRINT("PS 2D init ");
   if (!strip.isMatrix) return false; // only for 2D
   uint32_t cols = SEGMENT.virtualWidth();
@@ -1134,13 +1210,24 @@ bool initParticleSystem2D(ParticleSystem2D *&PartSys, uint32_t requestedsources,
   PSPRINT(" segmentsize:" + String(cols) + " x " + String(rows));
   PSPRINT(" request numparticles:" + String(numparticles));
   uint32_t numsources = calculateNumberOfSources2D(pixels, requestedsources);
-  if (!allocateParticleSystemMemory2D(numparticles, numsources, advanced, sizecontrol, additionalbytes))
+  uint32_t collisiontable = collisions ? calculateCollisionTableSize2D(cols, rows) : 0; // only FX that use collisions need the grid
+  // effect memory is shared by all segments and by the old effect during a transition: use fewer particles if the full amount does not fit
+  uint32_t requiredmemory = calculateParticleSystemMemory2D(numparticles, numsources, advanced, sizecontrol, additionalbytes, collisiontable);
+  uint32_t availablememory = SEGMENT.availableDataSize();
+  if (requiredmemory > availablememory) {
+    uint32_t basememory = calculateParticleSystemMemory2D(0, numsources, advanced, sizecontrol, additionalbytes, collisiontable);
+    uint32_t particlememory = (requiredmemory - basememory) / numparticles; // bytes per particle
+    numparticles = availablememory > basememory ? ((availablememory - basememory) / particlememory) & ~0x03 : 0; // keep it a multiple of 4
+    PSPRINT(" reduced numparticles:" + String(numparticles));
+  }
+  // never go below the minimum calculateNumberOfParticles2D() would return: effects are not designed to run with fewer particles, fall back to solid instead
+  if (numparticles < PS_MINPARTICLES || !allocateParticleSystemMemory2D(numparticles, numsources, advanced, sizecontrol, additionalbytes, collisiontable))
   {
     DEBUG_PRINT(F("PS init failed: memory depleted"));
     return false;
   }
 
-  PartSys = new (SEGENV.data) ParticleSystem2D(cols, rows, numparticles, numsources, advanced, sizecontrol); // particle system constructor
+  PartSys = new (SEGENV.data) ParticleSystem2D(cols, rows, numparticles, numsources, advanced, sizecontrol, collisiontable); // particle system constructor
 
   PSPRINTLN("******init done, pointers:");
   return true;
@@ -1168,7 +1255,9 @@ ParticleSystem1D::ParticleSystem1D(uint32_t length, uint32_t numberofparticles,
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
   emitIndex = 0;
-  collisionStartIdx = 0;
+  for (uint32_t i = 0; i < numParticles; i++) {
+    particleOrder[i] = i; // start with unsorted order, collision detection sorts it
+  }
   // initialize some default non-zero values most FX use
   for (uint32_t i = 0; i < numSources; i++) {
     sources[i].source.ttl = 1; //set source alive
@@ -1283,10 +1372,10 @@ int32_t ParticleSystem1D::sprayEmit(const PSsource1D &emitter) {
     if (emitIndex >= usedParticles)
       emitIndex = 0;
     if (particles[emitIndex].ttl == 0) { // find a dead particle
-      particles[emitIndex].vx = emitter.v + hw_random16(emitter.var << 1) - emitter.var; // random(-var,var)
+      particles[emitIndex].vx = emitter.v + SEGMENT.prng16(emitter.var << 1) - emitter.var; // random(-var,var)
       particles[emitIndex].x = emitter.source.x;
       particles[emitIndex].hue = emitter.source.hue;
-      particles[emitIndex].ttl = hw_random16(emitter.minLife, emitter.maxLife);
+      particles[emitIndex].ttl = SEGMENT.prng16(emitter.minLife, emitter.maxLife);
       particleFlags[emitIndex].collide = emitter.sourceFlags.collide; // TODO: could just set all flags (asByte) but need to check if that breaks any of the FX
       particleFlags[emitIndex].reversegrav = emitter.sourceFlags.reversegrav;
       particleFlags[emitIndex].perpetual = emitter.sourceFlags.perpetual;
@@ -1435,28 +1524,28 @@ void ParticleSystem1D::applyFriction(int32_t coefficient) {
 // if wrap is set, particles half out of bounds are rendered to the other side of the matrix
 // warning: do not render out of bounds particles or system will crash! rendering does not check if particle is out of bounds
 void ParticleSystem1D::render() {
-  CRGB baseRGB;
+  uint32_t baseRGB;
   uint32_t brightness; // particle brightness, fades if dying
   TBlendType blend = LINEARBLEND; // default color rendering: wrap palette
   if (particlesettings.colorByAge || particlesettings.colorByPosition) {
     blend = LINEARBLEND_NOWRAP;
   }
 
-  #ifdef ESP8266 // no local buffer on ESP8266
-  if (motionBlur)
-    SEGMENT.fadeToBlackBy(255 - motionBlur);
-  else
-    SEGMENT.fill(BLACK); // clear the buffer before rendering to it
-  #else
-  if (motionBlur) { // blurring active
+  framebuffer = SEGMENT.is2D() ? nullptr : SEGMENT.getPixels(); // render directly to the segment buffer unless the 1D FX is mapped to a 2D segment
+  if (!framebuffer) { // render through segment functions
+    if (motionBlur)
+      SEGMENT.fadeToBlackBy(255 - motionBlur);
+    else
+      SEGMENT.fill(BLACK); // clear the buffer before rendering to it
+  }
+  else if (motionBlur) { // blurring active
     for (int32_t x = 0; x <= maxXpixel; x++) {
       fast_color_scale(framebuffer[x], motionBlur);
     }
   }
   else { // no blurring: clear buffer
-    memset(framebuffer, 0, (maxXpixel+1) * sizeof(CRGB));
+    memset(framebuffer, 0, (maxXpixel+1) * sizeof(uint32_t));
   }
-  #endif
   // go over particles and render them to the buffer
   for (uint32_t i = 0; i < usedParticles; i++) {
     if ( particles[i].ttl == 0 || particleFlags[i].outofbounds)
@@ -1467,50 +1556,34 @@ void ParticleSystem1D::render() {
     baseRGB = ColorFromPaletteWLED(SEGPALETTE, particles[i].hue, 255, blend);
 
     if (advPartProps) { //saturation is advanced property in 1D system
-      if (advPartProps[i].sat < 255) {
-        CHSV32 baseHSV;
-        rgb2hsv((uint32_t((byte(baseRGB.r) << 16) | (byte(baseRGB.g) << 8) | (byte(baseRGB.b)))), baseHSV); // convert to HSV
-        baseHSV.s = min(baseHSV.s, advPartProps[i].sat); // set the saturation but don't increase it
-        uint32_t tempcolor;
-        hsv2rgb(baseHSV, tempcolor); // convert back to RGB
-        baseRGB = (CRGB)tempcolor;
-      }
+      if (advPartProps[i].sat < 255)
+        baseRGB = desaturate(baseRGB, advPartProps[i].sat);
     }
     brightness = gamma8(brightness); // apply gamma correction, used for gamma-inverted brightness distribution
     renderParticle(i, brightness, baseRGB, particlesettings.wrap);
   }
   // apply smear-blur to rendered frame
   if (smearBlur) {
-    #ifdef ESP8266
-    SEGMENT.blur(smearBlur, true); // no local buffer on ESP8266
-    #else
-    blur1D(framebuffer, maxXpixel + 1, smearBlur, 0);
-    #endif
+    if (framebuffer)
+      blur1D(framebuffer, maxXpixel + 1, smearBlur, 0);
+    else
+      SEGMENT.blur(smearBlur, true);
   }
 
   // add background color
   uint32_t bg_color = SEGCOLOR(1);
   if (bg_color > 0) { //if not black
-    CRGB bg_color_crgb = bg_color; // convert to CRGB
     for (int32_t i = 0; i <= maxXpixel; i++) {
-      #ifdef ESP8266 // no local buffer on ESP8266
-      SEGMENT.addPixelColor(i, bg_color, true);
-      #else
-      fast_color_add(framebuffer[i], bg_color_crgb);
-      #endif
+      if (framebuffer)
+        fast_color_add(framebuffer[i], bg_color);
+      else
+        SEGMENT.addPixelColor(i, bg_color, true);
     }
   }
-
-  #ifndef ESP8266
-  // transfer the frame-buffer to segment
-  for (int x = 0; x <= maxXpixel; x++) {
-    SEGMENT.setPixelColor(x, framebuffer[x]);
-  }
-  #endif
 }
 
 // calculate pixel positions and brightness distribution and render the particle to local buffer or global buffer
-__attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGB &color, const bool wrap) {
+__attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint32_t particleindex, const uint8_t brightness, const uint32_t color, const bool wrap) {
   uint32_t size = particlesize;
   if (advPartProps) // use advanced size properties (1D system has no large size global rendering TODO: add large global rendering?)
     size = advPartProps[particleindex].size;
@@ -1518,11 +1591,10 @@ __attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint
   if (size == 0) { //single pixel particle, can be out of bounds as oob checking is made for 2-pixel particles (and updating it uses more code)
     uint32_t x =  particles[particleindex].x >> PS_P_RADIUS_SHIFT_1D;
     if (x <= (uint32_t)maxXpixel) { //by making x unsigned there is no need to check < 0 as it will overflow
-      #ifdef ESP8266 // no local buffer on ESP8266
-      SEGMENT.addPixelColor(x, color.scale8(brightness), true);
-      #else
-      fast_color_add(framebuffer[x], color, brightness);
-      #endif
+      if (framebuffer)
+        fast_color_add(framebuffer[x], color, brightness);
+      else
+        SEGMENT.addPixelColor(x, color_fade(color, brightness), true);
     }
     return;
   }
@@ -1553,7 +1625,7 @@ __attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint
 
   // check if particle has advanced size properties and buffer is available
   if (advPartProps && advPartProps[particleindex].size > 1) {
-    CRGB renderbuffer[10]; // 10 pixel buffer
+    uint32_t renderbuffer[10]; // 10 pixel buffer
     memset(renderbuffer, 0, sizeof(renderbuffer)); // clear buffer
     //render particle to a bigger size
     //particle size to pixels: 2 - 63 is 4 pixels, < 128 is 6pixels, < 192 is 8 pixels, bigger is 10 pixels
@@ -1590,11 +1662,10 @@ __attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint
         else
           continue;
       }
-      #ifdef ESP8266 // no local buffer on ESP8266
-      SEGMENT.addPixelColor(xfb, renderbuffer[xrb], true);
-      #else
-      fast_color_add(framebuffer[xfb], renderbuffer[xrb]);
-      #endif
+      if (framebuffer)
+        fast_color_add(framebuffer[xfb], renderbuffer[xrb]);
+      else
+        SEGMENT.addPixelColor(xfb, renderbuffer[xrb], true);
     }
   }
   else { // standard rendering (2 pixels per particle)
@@ -1613,11 +1684,10 @@ __attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint
     }
     for (uint32_t i = 0; i < 2; i++) {
       if (pxlisinframe[i]) {
-        #ifdef ESP8266 // no local buffer on ESP8266
-        SEGMENT.addPixelColor(pixco[i], color.scale8((uint8_t)pxlbrightness[i]), true);
-        #else
-        fast_color_add(framebuffer[pixco[i]], color, pxlbrightness[i]);
-        #endif
+        if (framebuffer)
+          fast_color_add(framebuffer[pixco[i]], color, pxlbrightness[i]);
+        else
+          SEGMENT.addPixelColor(pixco[i], color_fade(color, pxlbrightness[i]), true);
       }
     }
   }
@@ -1625,58 +1695,66 @@ __attribute__((optimize("O2"))) void ParticleSystem1D::renderParticle(const uint
 }
 
 // detect collisions in an array of particles and handle them
+// uses sort and sweep: particleOrder holds the particle indices sorted by (lookahead) position and is kept from frame to frame
+// only colliding particles are sorted, they are moved to the front of particleOrder (dead or non-colliding particles are skipped)
+// particles move little between frames, so an insertion sort restores the order in close to linear time
+// respawned particles (emitted far from their old position) can make insertion sort quadratic, it switches to a full sort if too many entries get shifted
+// in the sweep, each particle only checks the following particles in sorted order until they are out of collision distance
 void ParticleSystem1D::handleCollisions() {
+  const auto position = [&](uint32_t idx) { return particles[idx].x + particles[idx].vx; }; // position with lookahead
+  const auto isColliding = [&](uint32_t idx) { // note: checking flags is quite slow and usually these are set, so check ttl first
+    return idx < usedParticles && particles[idx].ttl > 0 && particleFlags[idx].outofbounds == 0 && particleFlags[idx].collide;
+  };
+
+  // move colliding particles to the front, keeping their order from the last frame (all allocated particles stay in particleOrder)
+  uint32_t colliding = 0;
+  for (uint32_t i = 0; i < numParticles; i++) {
+    if (isColliding(particleOrder[i])) {
+      uint16_t idx = particleOrder[i];
+      particleOrder[i] = particleOrder[colliding];
+      particleOrder[colliding++] = idx;
+    }
+  }
+
+  // insertion sort of the colliding particles
+  const uint32_t maxShifts = colliding << 2; // on average, particles move less than 4 places in the order from one frame to the next
+  uint32_t shifts = 0;
+  for (uint32_t i = 1; i < colliding; i++) {
+    uint16_t idx = particleOrder[i];
+    int32_t pos = position(idx);
+    uint32_t j = i;
+    while (j > 0 && position(particleOrder[j - 1]) > pos) {
+      particleOrder[j] = particleOrder[j - 1];
+      j--;
+    }
+    particleOrder[j] = idx;
+    shifts += i - j;
+    if (shifts > maxShifts) { // order changed a lot (particles were respawned), sort the rest in O(n log n)
+      std::sort(particleOrder, particleOrder + colliding, [&](uint16_t a, uint16_t b) { return position(a) < position(b); });
+      break;
+    }
+  }
+
   uint32_t collisiondistance = particleHardRadius << 1;
-  // note: partices are binned by position, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  constexpr int BIN_WIDTH = 32 * PS_P_RADIUS_1D; // width of each bin, a compromise between speed and accuracy (larger bins are faster but collapse more)
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
+  uint32_t maxCollisionDistance = collisiondistance;
   if (advPartProps) //may be using individual particle size
-    overlap += 256; // add 2 * max radius (approximately)
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 4); // do not bin small amounts, limit max to 1/4 of particles
-  uint32_t numBins = (maxX + (BIN_WIDTH - 1)) / BIN_WIDTH; // calculate number of bins
-  uint16_t binIndices[maxBinParticles]; // array to store indices of particles in a bin
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint16_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * BIN_WIDTH - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + BIN_WIDTH + overlap; // note: last bin can be out of bounds, see above
-
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // alivee
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if(particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
+    maxCollisionDistance = (PS_P_MINHARDRADIUS_1D << particlesize) + 255; // max of individual sizes (see below)
+
+  for (uint32_t i = 0; i < colliding; i++) {
+    uint32_t idx_i = particleOrder[i];
+    for (uint32_t j = i + 1; j < colliding; j++) { // check against particles further up, stop as soon as they are out of reach
+      uint32_t idx_j = particleOrder[j];
+      int32_t dx = position(idx_j) - position(idx_i); // distance between particles with lookahead
+      if (dx > (int32_t)maxCollisionDistance) break;
+      if (advPartProps) { // use advanced size properties
+        collisiondistance = (PS_P_MINHARDRADIUS_1D << particlesize) + ((advPartProps[idx_i].size + advPartProps[idx_j].size) >> 1);
       }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
-    }
-
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (advPartProps) { // use advanced size properties
-          collisiondistance = (PS_P_MINHARDRADIUS_1D << particlesize) + ((advPartProps[idx_i].size + advPartProps[idx_j].size) >> 1);
-        }
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance between particles with lookahead
-        uint32_t dx_abs = abs(dx);
-        if (dx_abs <= collisiondistance) { // collide if close
-          collideParticles(particles[idx_i], particleFlags[idx_i], particles[idx_j], particleFlags[idx_j], dx, dx_abs, collisiondistance);
-        }
+      uint32_t dx_abs = abs(dx); // note: pushing particles in a collision can change positions, so dx may become negative
+      if (dx_abs <= collisiondistance) { // collide if close
+        collideParticles(particles[idx_i], particleFlags[idx_i], particles[idx_j], particleFlags[idx_j], dx, dx_abs, collisiondistance);
       }
     }
   }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
 // takes two pointers to the particles to collide and the particle hardness (softer means more energy lost in collision, 255 means full hard)
@@ -1767,16 +1845,9 @@ void ParticleSystem1D::updatePSpointers(bool isadvanced) {
   // by making sure that the number of sources and particles is a multiple of 4, padding can be skipped here as alignent is ensured, independent of struct sizes.
   particles = reinterpret_cast<PSparticle1D *>(this + 1); // pointer to particles
   particleFlags = reinterpret_cast<PSparticleFlags1D *>(particles + numParticles); // pointer to particle flags
-  sources = reinterpret_cast<PSsource1D *>(particleFlags + numParticles); // pointer to source(s)
-  #ifdef ESP8266 // no local buffer on ESP8266
-  PSdataEnd = reinterpret_cast<uint8_t *>(sources + numSources);
-  #else
-  framebuffer = reinterpret_cast<CRGB *>(sources + numSources); // pointer to framebuffer
-  // align pointer after framebuffer to 4bytes
-  uintptr_t p = reinterpret_cast<uintptr_t>(framebuffer + (maxXpixel+1)); // maxXpixel is SEGMENT.virtualLength() - 1
-  p = (p + 3) & ~0x03; // align to 4-byte boundary
-  PSdataEnd = reinterpret_cast<uint8_t *>(p); // pointer to first available byte after the PS for FX additional data
-  #endif
+  particleOrder = reinterpret_cast<uint16_t *>(particleFlags + numParticles); // pointer to collision order
+  sources = reinterpret_cast<PSsource1D *>(particleOrder + numParticles); // pointer to source(s)
+  PSdataEnd = reinterpret_cast<uint8_t *>(sources + numSources); // pointer to first available byte after the PS for FX additional data
   if (isadvanced) {
     advPartProps = reinterpret_cast<PSadvancedParticle1D *>(PSdataEnd);
     PSdataEnd = reinterpret_cast<uint8_t *>(advPartProps + numParticles); // since numParticles is a multiple of 4, this is always aligned to 4 bytes. No need to add padding bytes here
@@ -1808,7 +1879,7 @@ uint32_t calculateNumberOfParticles1D(const uint32_t fraction, const bool isadva
   if (isadvanced) // advanced property array needs ram, reduce number of particles to use the same amount
     numberofParticles = (numberofParticles * sizeof(PSparticle1D)) / (sizeof(PSparticle1D) + sizeof(PSadvancedParticle1D));
   numberofParticles = (numberofParticles * (fraction + 1)) >> 8; // calculate fraction of particles
-  numberofParticles = numberofParticles < 20 ? 20 : numberofParticles; // 20 minimum
+  numberofParticles = numberofParticles < PS_MINPARTICLES_1D ? PS_MINPARTICLES_1D : numberofParticles; // minimum
   //make sure it is a multiple of 4 for proper memory alignment (easier than using padding bytes)
   numberofParticles = (numberofParticles+3) & ~0x03; // note: with a separate particle buffer, this is probably unnecessary
   PSPRINTLN(" calc numparticles:" + String(numberofParticles))
@@ -1828,20 +1899,23 @@ uint32_t calculateNumberOfSources1D(const uint32_t requestedsources) {
   return numberofSources;
 }
 
-//allocate memory for particle system class, particles, sprays plus additional memory requested by FX
-bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes) {
+// memory required for particle system class, particles, sprays plus additional memory requested by FX
+uint32_t calculateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes) {
   uint32_t requiredmemory = sizeof(ParticleSystem1D);
   // functions above make sure these are a multiple of 4 bytes (to avoid alignment issues)
   requiredmemory += sizeof(PSparticleFlags1D) * numparticles;
   requiredmemory += sizeof(PSparticle1D) * numparticles;
+  requiredmemory += sizeof(uint16_t) * numparticles; // collision order
   requiredmemory += sizeof(PSsource1D) * numsources;
-  #ifndef ESP8266 // no local buffer on ESP8266
-  requiredmemory += sizeof(CRGB) * SEGMENT.virtualLength();
-  #endif
   requiredmemory += additionalbytes + 3; // add 3 to ensure room for stuffing bytes to make it 4 byte aligned
   if (isadvanced)
     requiredmemory += sizeof(PSadvancedParticle1D) * numparticles;
-  return(SEGMENT.allocateData(requiredmemory));
+  return requiredmemory;
+}
+
+//allocate memory for particle system class, particles, sprays plus additional memory requested by FX
+bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes) {
+  return(SEGMENT.allocateData(calculateParticleSystemMemory1D(numparticles, numsources, isadvanced, additionalbytes))); // note: an existing (larger) buffer is reused
 }
 
 // initialize Particle System, allocate additional bytes if needed (pointer to those bytes can be read from particle system class: PSdataEnd)
@@ -1850,7 +1924,16 @@ bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedso
   if (SEGLEN == 1) return false; // single pixel not supported
   uint32_t numparticles = calculateNumberOfParticles1D(fractionofparticles, advanced);
   uint32_t numsources = calculateNumberOfSources1D(requestedsources);
-  if (!allocateParticleSystemMemory1D(numparticles, numsources, advanced, additionalbytes)) {
+  // effect memory is shared by all segments and by the old effect during a transition: use fewer particles if the full amount does not fit
+  uint32_t requiredmemory = calculateParticleSystemMemory1D(numparticles, numsources, advanced, additionalbytes);
+  uint32_t availablememory = SEGMENT.availableDataSize();
+  if (requiredmemory > availablememory) {
+    uint32_t basememory = calculateParticleSystemMemory1D(0, numsources, advanced, additionalbytes);
+    uint32_t particlememory = (requiredmemory - basememory) / numparticles; // bytes per particle
+    numparticles = availablememory > basememory ? ((availablememory - basememory) / particlememory) & ~0x03 : 0; // keep it a multiple of 4
+    PSPRINTLN(" reduced numparticles:" + String(numparticles));
+  }
+  if (numparticles < PS_MINPARTICLES_1D || !allocateParticleSystemMemory1D(numparticles, numsources, advanced, additionalbytes)) { // same minimum as calculateNumberOfParticles1D()
     DEBUG_PRINT(F("PS init failed: memory depleted"));
     return false;
   }
@@ -1861,9 +1944,9 @@ bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedso
 // blur a 1D buffer, sub-size blurring can be done using start and size
 // for speed, 32bit variables are used, make sure to limit them to 8bit (0-255) or result is undefined
 // to blur a subset of the buffer, change the size and set start to the desired starting coordinates
-void blur1D(CRGB *colorbuffer, uint32_t size, uint32_t blur, uint32_t start)
+void blur1D(uint32_t *colorbuffer, uint32_t size, uint32_t blur, uint32_t start)
 {
-  CRGB seeppart, carryover;
+  uint32_t seeppart, carryover;
   uint32_t seep = blur >> 1;
   carryover =  BLACK;
   for (uint32_t x = start; x < start + size; x++) {
@@ -1921,43 +2004,55 @@ static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32
   return true; // particle is in bounds
 }
 
+// same result as rgb2hsv(), limiting saturation to sat and hsv2rgb() (within +/-3) but without the round trip:
+// at constant hue and value, each channel's distance to the maximum channel scales with saturation
+static uint32_t desaturate(const uint32_t rgb, const uint8_t sat) {
+  int32_t r = R(rgb), g = G(rgb), b = B(rgb);
+  int32_t maxval = max(max(r, g), b);
+  int32_t delta = maxval - min(min(r, g), b);
+  if (delta == 0 || (255 * delta) / maxval <= sat) return rgb; // gray or already less saturated
+  uint32_t scale = (((uint32_t)(maxval * sat) / 255) << 16) / delta; // new delta / old delta in 16.16 fixed point
+  r = maxval - (((maxval - r) * scale + 32768) >> 16);
+  g = maxval - (((maxval - g) * scale + 32768) >> 16);
+  b = maxval - (((maxval - b) * scale + 32768) >> 16);
+  return RGBW32(r, g, b, 0);
+}
+
 // fastled color adding is very inaccurate in color preservation (but it is fast)
-// a better color add function is implemented in colors.cpp but it uses 32bit RGBW. to use it colors need to be shifted just to then be shifted back by that function, which is slow
-// this is a fast version for RGB (no white channel, PS does not handle white) and with native CRGB including scaling of second color
-// note: result is stored in c1, not using a return value is faster as the CRGB struct does not need to be copied upon return
+// color_add() in colors.cpp preserves color ratios but handles white and has no scaling of the second color
+// this is a fast version for RGB (no white channel, PS does not handle white) on 32bit colors as used in the segment buffer, including scaling of second color
+// note: result is stored in c1
 // note2: function is mainly used to add scaled colors, so checking if one color is black is slower
 // note3: scale is 255 when using blur, checking for that makes blur faster
- __attribute__((optimize("O2"))) static void fast_color_add(CRGB &c1, const CRGB &c2, const uint8_t scale) {
+ __attribute__((optimize("O2"))) static void fast_color_add(uint32_t &c1, const uint32_t c2, const uint8_t scale) {
   uint32_t r, g, b;
   if (scale < 255) {
-    r = c1.r + ((c2.r * scale) >> 8);
-    g = c1.g + ((c2.g * scale) >> 8);
-    b = c1.b + ((c2.b * scale) >> 8);
+    r = R(c1) + ((R(c2) * scale) >> 8);
+    g = G(c1) + ((G(c2) * scale) >> 8);
+    b = B(c1) + ((B(c2) * scale) >> 8);
   } else {
-    r = c1.r + c2.r;
-    g = c1.g + c2.g;
-    b = c1.b + c2.b;
+    r = R(c1) + R(c2);
+    g = G(c1) + G(c2);
+    b = B(c1) + B(c2);
   }
 
   // note: this chained comparison is the fastest method for max of 3 values (faster than std:max() or using xor)
   uint32_t max = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
-  if (max <= 255) {
-    c1.r = r; // save result to c1
-    c1.g = g;
-    c1.b = b;
-  } else {
+  if (max > 255) {
     uint32_t newscale = (255U << 16) / max;
-    c1.r = (r * newscale) >> 16;
-    c1.g = (g * newscale) >> 16;
-    c1.b = (b * newscale) >> 16;
+    r = (r * newscale) >> 16;
+    g = (g * newscale) >> 16;
+    b = (b * newscale) >> 16;
   }
+  c1 = RGBW32(r, g, b, 0); // save result to c1
 }
 
-// faster than fastled color scaling as it does in place scaling
- __attribute__((optimize("O2"))) static void fast_color_scale(CRGB &c, const uint8_t scale) {
-  c.r = ((c.r * scale) >> 8);
-  c.g = ((c.g * scale) >> 8);
-  c.b = ((c.b * scale) >> 8);
+// in place scaling, scales R and B as well as G and W at once
+ __attribute__((optimize("O2"))) static void fast_color_scale(uint32_t &c, const uint8_t scale) {
+  constexpr uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = (((c & TWO_CHANNEL_MASK) * scale) >> 8) & TWO_CHANNEL_MASK;
+  uint32_t wg = (((c >> 8) & TWO_CHANNEL_MASK) * scale) & ~TWO_CHANNEL_MASK;
+  c = rb | wg;
 }
 
 #endif  // !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D))
@@ -18,7 +18,6 @@
 #include "wled.h"
 
 #define PS_P_MAXSPEED 120 // maximum speed a particle can have (vx/vy is int8)
-#define MAX_MEMIDLE 10 // max idle time (in frames) before memory is deallocated (if deallocated during an effect, it will crash!)
 
 //#define WLED_DEBUG_PS // note: enabling debug uses ~3k of flash
 
@@ -44,6 +43,7 @@ static inline int32_t limitSpeed(const int32_t speed) {
 #define ESP32S2_MAXSOURCES 64
 #define ESP32_MAXPARTICLES 2048 // enough up to 64x32 pixels
 #define ESP32_MAXSOURCES 128
+#define PS_MINPARTICLES 4 // lower limit of calculateNumberOfParticles2D(), also the smallest count that keeps the particle arrays 4-byte aligned
 
 // particle dimensions (subpixel division)
 #define PS_P_RADIUS 64 // subpixel size, each pixel is divided by this for particle movement (must be a power of 2)
@@ -52,6 +52,12 @@ static inline int32_t limitSpeed(const int32_t speed) {
 #define PS_P_SURFACE 12 // shift: 2^PS_P_SURFACE = (PS_P_RADIUS)^2
 #define PS_P_MINHARDRADIUS 64 // minimum hard surface radius for collisions
 #define PS_P_MINSURFACEHARDNESS 128 // minimum hardness used in collision impulse calculation, below this hardness, particles become sticky
+#define PS_SPRITECACHE_SIZE 32 // number of cached sprite profiles for advanced size particles (must be a power of 2)
+#ifdef ESP8266
+#define PS_MAX_COLLISION_CELLS 256 // collision grid cells, limits memory use on large matrices (cells are enlarged if there would be more)
+#else
+#define PS_MAX_COLLISION_CELLS 1024
+#endif
 
 // struct for PS settings (shared for 1D and 2D class)
 typedef union {
@@ -118,6 +124,12 @@ typedef struct { // 8 bytes
 } PSsizeControl;
 
 
+// struct for cached brightness profile of a sized particle along one axis (advanced particles), the sprite is the product of the x and y profile
+typedef struct { // 22 bytes
+  uint16_t key; // particle size and quantized sub-pixel offset, 0 means unused
+  uint16_t profile[10]; // brightness of the 10 pixels covered by the largest particle size (can exceed 255)
+} PSspriteProfile;
+
 //struct for a particle source (20 bytes)
 typedef struct {
   uint16_t minLife; // minimum ttl of emittet particles
@@ -133,7 +145,7 @@ typedef struct {
 // class uses approximately 60 bytes
 class ParticleSystem2D {
 public:
-  ParticleSystem2D(const uint32_t width, const uint32_t height, const uint32_t numberofparticles, const uint32_t numberofsources, const bool isadvanced = false,  const bool sizecontrol = false); // constructor
+  ParticleSystem2D(const uint32_t width, const uint32_t height, const uint32_t numberofparticles, const uint32_t numberofsources, const bool isadvanced = false,  const bool sizecontrol = false, const uint32_t collisiontable = 0); // constructor
   // note: memory is allcated in the FX function, no deconstructor needed
   void update(void); //update the particles according to set options and render to the matrix
   void updateFire(const uint8_t intensity, const bool renderonly); // update function for fire, if renderonly is set, particles are not updated (required to fix transitions with frameskips)
@@ -171,7 +183,7 @@ public:
   void setSmearBlur(const uint8_t bluramount); // enable 2D smeared blurring of full frame
   void setParticleSize(const uint8_t size);
   void setGravity(const int8_t force = 8);
-  void enableParticleCollisions(const bool enable, const uint8_t hardness = 255);
+  void enableParticleCollisions(const bool enable, const uint8_t hardness = 255); // note: collisions need a grid, request it in initParticleSystem2D()
 
   PSparticle *particles; // pointer to particle array
   PSparticleFlags *particleFlags; // pointer to particle flags array
@@ -188,7 +200,7 @@ public:
 private:
   //rendering functions
   void render();
-  [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGB& color, const bool wrapX, const bool wrapY);
+  [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const uint32_t color, const bool wrapX, const bool wrapY);
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
   void handleCollisions();
@@ -198,9 +210,13 @@ private:
   void updatePSpointers(const bool isadvanced, const bool sizecontrol); // update the data pointers to current segment data space
   bool updateSize(PSadvancedParticle *advprops, PSsizeControl *advsize); // advanced size control
   void getParticleXYsize(PSadvancedParticle *advprops, PSsizeControl *advsize, uint32_t &xsize, uint32_t &ysize);
+  const uint16_t *getSpriteProfile(const uint32_t size, const uint32_t offset); // cached brightness profile for advanced size rendering
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
-  CRGB *framebuffer; // local frame buffer for rendering
+  uint32_t *framebuffer; // segment pixel buffer, particles are rendered directly to it (set in render())
+  PSspriteProfile *spriteCache; // cached sprite profiles (only allocated for advanced particles)
+  uint16_t *collisionCells; // collision grid: start index of each cell (collisionTableSize) followed by the sorted particle indices (numParticles), nullptr if not reserved
+  uint32_t collisionTableSize; // cell start entries in the collision grid (number of cells + 1, rounded up to a multiple of 4), 0 if no grid is reserved
   PSsettings2D particlesettings; // settings used when updating particles (can also used by FX to move sources), do not edit properties directly, use functions above
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
@@ -208,7 +224,6 @@ private:
   uint32_t wallHardness;
   uint32_t wallRoughness; // randomizes wall collisions  
   uint32_t particleHardRadius; // hard surface radius of a particle, used for collision detection (32bit for speed)
-  uint16_t collisionStartIdx; // particle array start index for collision detection
   uint8_t fireIntesity = 0; // fire intensity, used for fire mode (flash use optimization, better than passing an argument to render function)
   uint8_t forcecounter; // counter for globally applied forces
   uint8_t gforcecounter; // counter for global gravity
@@ -219,12 +234,14 @@ private:
   uint8_t smearBlur; // 2D smeared blurring of full frame
 };
 
-void blur2D(CRGB *colorbuffer, const uint32_t xsize, uint32_t ysize, const uint32_t xblur, const uint32_t yblur, const uint32_t xstart = 0, uint32_t ystart = 0, const bool isparticle = false);
+void blur2D(uint32_t *colorbuffer, const uint32_t xsize, uint32_t ysize, const uint32_t xblur, const uint32_t yblur, const uint32_t xstart = 0, uint32_t ystart = 0, const bool isparticle = false);
 // initialization functions (not part of class)
-bool initParticleSystem2D(ParticleSystem2D *&PartSys, const uint32_t requestedsources, const uint32_t additionalbytes = 0, const bool advanced = false, const bool sizecontrol = false);
+bool initParticleSystem2D(ParticleSystem2D *&PartSys, const uint32_t requestedsources, const uint32_t additionalbytes = 0, const bool advanced = false, const bool sizecontrol = false, const bool collisions = false);
 uint32_t calculateNumberOfParticles2D(const uint32_t pixels, const bool advanced, const bool sizecontrol);
 uint32_t calculateNumberOfSources2D(const uint32_t pixels, const uint32_t requestedsources);
-bool allocateParticleSystemMemory2D(const uint32_t numparticles, const uint32_t numsources, const bool advanced, const bool sizecontrol, const uint32_t additionalbytes);
+uint32_t calculateCollisionTableSize2D(const uint32_t cols, const uint32_t rows);
+uint32_t calculateParticleSystemMemory2D(const uint32_t numparticles, const uint32_t numsources, const bool advanced, const bool sizecontrol, const uint32_t additionalbytes, const uint32_t collisiontable = 0);
+bool allocateParticleSystemMemory2D(const uint32_t numparticles, const uint32_t numsources, const bool advanced, const bool sizecontrol, const uint32_t additionalbytes, const uint32_t collisiontable = 0);
 #endif // WLED_DISABLE_PARTICLESYSTEM2D
 
 ////////////////////////
@@ -238,6 +255,7 @@ bool allocateParticleSystemMemory2D(const uint32_t numparticles, const uint32_t
 #define ESP32S2_MAXSOURCES_1D 32
 #define ESP32_MAXPARTICLES_1D 2600
 #define ESP32_MAXSOURCES_1D 64
+#define PS_MINPARTICLES_1D 20 // lower limit of calculateNumberOfParticles1D()
 
 // particle dimensions (subpixel division)
 #define PS_P_RADIUS_1D 32 // subpixel size, each pixel is divided by this for particle movement, if this value is changed, also change the shift defines (next two lines)
@@ -351,7 +369,7 @@ public:
 private:
   //rendering functions
   void render(void);
-  [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGB &color, const bool wrap);
+  [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const uint32_t color, const bool wrap);
 
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
@@ -363,9 +381,8 @@ private:
   //void updateSize(PSadvancedParticle *advprops, PSsizeControl *advsize); // advanced size control
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
-  #ifndef ESP8266
-  CRGB *framebuffer; // local frame buffer for rendering
-  #endif
+  uint32_t *framebuffer; // segment pixel buffer, particles are rendered directly to it (set in render(), nullptr if 1D FX is mapped to a 2D segment)
+  uint16_t *particleOrder; // particle indices sorted by position, kept between frames for collision detection
   PSsettings1D particlesettings; // settings used when updating particles
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
@@ -375,7 +392,6 @@ private:
   uint8_t gforcecounter; // counter for global gravity
   int8_t gforce; // gravity strength, default is 8 (negative is allowed, positive is downwards)
   uint8_t forcecounter; // counter for globally applied forces
-  uint16_t collisionStartIdx; // particle array start index for collision detection
   //global particle properties for basic particles
   uint8_t particlesize; // global particle size, 0 = 1 pixel, 1 = 2 pixels, is overruled by advanced particle size
   uint8_t motionBlur; // enable motion blur, values > 100 gives smoother animations
@@ -385,6 +401,7 @@ private:
 bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedsources, const uint8_t fractionofparticles = 255, const uint32_t additionalbytes = 0, const bool advanced = false);
 uint32_t calculateNumberOfParticles1D(const uint32_t fraction, const bool isadvanced);
 uint32_t calculateNumberOfSources1D(const uint32_t requestedsources);
+uint32_t calculateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes);
 bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t numsources, const bool isadvanced, const uint32_t additionalbytes);
-void blur1D(CRGB *colorbuffer, uint32_t size, uint32_t blur, uint32_t start);
+void blur1D(uint32_t *colorbuffer, uint32_t size, uint32_t blur, uint32_t start);
 #endif // WLED_DISABLE_PARTICLESYSTEM1D
@@ -32,7 +32,7 @@ extern bool useParallelI2S;
 uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
 
 //udp.cpp
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const byte *buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const byte *buffer, uint8_t bri=255, bool isRGBW=false, uint16_t universe=E131_OUTPUT_UNIVERSE, uint8_t priority=E131_OUTPUT_PRIORITY, uint16_t syncUniverse=E131_OUTPUT_SYNC_UNIVERSE);
 
 //util.cpp
 // PSRAM allocation wrappers
@@ -688,6 +688,9 @@ BusNetwork::BusNetwork(const BusConfig &bc)
   _hasCCT = false;
   _UDPchannels = _hasWhite + 3;
   _client = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
+  _e131Universe = constrain(bc.e131Universe, 1, 63999);
+  _e131Priority = std::min(bc.e131Priority, (uint8_t)200);
+  _e131Sync = bc.e131Sync > 63999 ? 0 : bc.e131Sync;
   _data = (uint8_t*)d_calloc(_len, _UDPchannels);
   _valid = (_data != nullptr);
   DEBUGBUS_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3]);
@@ -713,7 +716,7 @@ uint32_t BusNetwork::getPixelColor(unsigned pix) const {
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite());
+  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite(), _e131Universe, _e131Priority, _e131Sync);
   _broadcastLock = false;
 }
 
@@ -729,6 +732,7 @@ std::vector<LEDType> BusNetwork::getLEDTypes() {
     {TYPE_NET_ARTNET_RGB,  "N",     PSTR("Art-Net RGB (network)")},
     {TYPE_NET_DDP_RGBW,    "N",     PSTR("DDP RGBW (network)")},
     {TYPE_NET_ARTNET_RGBW, "N",     PSTR("Art-Net RGBW (network)")},
+    {TYPE_NET_E131_RGB,    "N",     PSTR("E1.31 RGB (network)")},
     // hypothetical extensions
     //{TYPE_VIRTUAL_I2C_W,   "V",     PSTR("I2C White (virtual)")}, // allows setting I2C address in _pin[0]
     //{TYPE_VIRTUAL_I2C_CCT, "V",     PSTR("I2C CCT (virtual)")}, // allows setting I2C address in _pin[0]
@@ -345,12 +345,20 @@ class BusNetwork : public Bus {
 
     static std::vector<LEDType> getLEDTypes();
 
+    // E1.31 output settings (TYPE_NET_E131_RGB only)
+    inline uint16_t getE131Universe() const     { return _e131Universe; }
+    inline uint8_t  getE131Priority() const     { return _e131Priority; }
+    inline uint16_t getE131SyncUniverse() const { return _e131Sync; }
+
   private:
     IPAddress _client;
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
     bool      _broadcastLock;
     uint8_t   *_data;
+    uint16_t  _e131Universe;
+    uint16_t  _e131Sync;
+    uint8_t   _e131Priority;
 };
 
 
@@ -368,8 +376,12 @@ struct BusConfig {
   uint16_t frequency;
   uint8_t milliAmpsPerLed;
   uint16_t milliAmpsMax;
+  uint16_t e131Universe;  // E1.31 network bus: first universe, priority and sync universe (0 = no sync packets)
+  uint8_t  e131Priority;
+  uint16_t e131Sync;
 
-  BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, uint8_t maPerLed=LED_MILLIAMPS_DEFAULT, uint16_t maMax=ABL_MILLIAMPS_DEFAULT)
+  BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, uint8_t maPerLed=LED_MILLIAMPS_DEFAULT, uint16_t maMax=ABL_MILLIAMPS_DEFAULT,
+            uint16_t uni=E131_OUTPUT_UNIVERSE, uint8_t prio=E131_OUTPUT_PRIORITY, uint16_t sync=E131_OUTPUT_SYNC_UNIVERSE)
   : count(std::max(len,(uint16_t)1))
   , start(pstart)
   , colorOrder(pcolorOrder)
@@ -379,6 +391,9 @@ struct BusConfig {
   , frequency(clock_kHz)
   , milliAmpsPerLed(maPerLed)
   , milliAmpsMax(maMax)
+  , e131Universe(uni)
+  , e131Priority(prio)
+  , e131Sync(sync)
   {
     refreshReq = (bool) GET_BIT(busType,7);
     type = busType & 0x7F;  // bit 7 may be/is hacked to include refresh info (1=refresh in off state, 0=no refresh)
@@ -228,6 +228,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       uint8_t AWmode = elm[F("rgbwm")] | RGBW_MODE_MANUAL_ONLY;
       uint8_t maPerLed = elm[F("ledma")] | LED_MILLIAMPS_DEFAULT;
       uint16_t maMax = elm[F("maxpwr")] | (ablMilliampsMax * length) / total; // rough (incorrect?) per strip ABL calculation when no config exists
+      uint16_t e131Uni = elm[F("uni")] | E131_OUTPUT_UNIVERSE; // E1.31 network bus only
+      uint8_t e131Prio = elm[F("prio")] | E131_OUTPUT_PRIORITY;
+      uint16_t e131Sync = elm[F("sync")] | E131_OUTPUT_SYNC_UNIVERSE;
       // To disable brightness limiter we either set output max current to 0 or single LED current to 0 (we choose output max current)
       if (Bus::isPWM(ledType) || Bus::isOnOff(ledType) || Bus::isVirtual(ledType)) { // analog and virtual
         maPerLed = 0;
@@ -235,7 +238,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       }
       ledType |= refresh << 7; // hack bit 7 to indicate strip requires off refresh
 
-      busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, maPerLed, maMax);
+      busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, maPerLed, maMax, e131Uni, e131Prio, e131Sync);
       doInitBusses = true;  // finalization done in beginStrip()
       if (!Bus::isVirtual(ledType)) s++; // have as many virtual buses as you want
     }
@@ -477,7 +480,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   }
 
   CJSON(serialBaud, hw[F("baud")]);
-  if (serialBaud < 96 || serialBaud > 15000) serialBaud = 1152;
+  if (serialBaud < 96 || serialBaud > 30000) serialBaud = 1152;
   updateBaudRate(serialBaud *100);
 
   JsonArray hw_if_i2c = hw[F("if")][F("i2c-pin")];
@@ -600,6 +603,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_live_dmx = if_live["dmx"];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
   CJSON(e131SkipOutOfSequence, if_live_dmx[F("seqskip")]);
+  CJSON(e131WaitForFrame, if_live_dmx[F("frame")]);
   CJSON(DMXAddress, if_live_dmx[F("addr")]);
   if (!DMXAddress || DMXAddress > 510) DMXAddress = 1;
   CJSON(DMXSegmentSpacing, if_live_dmx[F("dss")]);
@@ -610,6 +614,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 
   tdd = if_live[F("timeout")] | -1;
   if (tdd >= 0) realtimeTimeoutMs = tdd * 100;
+  CJSON(udpReceiveBudget, if_live[F("rxbudget")]);
+  CJSON(realtimeJitterFrames, if_live[F("jitter")]);
+  if (realtimeJitterFrames > REALTIME_JITTER_MAX_FRAMES) realtimeJitterFrames = REALTIME_JITTER_MAX_FRAMES;
 
   #ifdef WLED_ENABLE_DMX_INPUT
     CJSON(dmxInputTransmitPin, if_live_dmx[F("inputRxPin")]);
@@ -976,6 +983,12 @@ void serializeConfig(JsonObject root) {
     ins[F("freq")]   = bus->getFrequency();
     ins[F("maxpwr")] = bus->getMaxCurrent();
     ins[F("ledma")]  = bus->getLEDCurrent();
+    if ((bus->getType() & 0x7F) == TYPE_NET_E131_RGB) {
+      const BusNetwork *net = static_cast<const BusNetwork *>(bus);
+      ins[F("uni")]  = net->getE131Universe();
+      ins[F("prio")] = net->getE131Priority();
+      ins[F("sync")] = net->getE131SyncUniverse();
+    }
   }
 
   JsonArray hw_com = hw.createNestedArray(F("com"));
@@ -1105,6 +1118,7 @@ void serializeConfig(JsonObject root) {
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
+  if_live_dmx[F("frame")] = e131WaitForFrame;
   if_live_dmx[F("e131prio")] = e131Priority;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
@@ -1117,6 +1131,8 @@ void serializeConfig(JsonObject root) {
   #endif
 
   if_live[F("timeout")] = realtimeTimeoutMs / 100;
+  if_live[F("rxbudget")] = udpReceiveBudget;
+  if_live[F("jitter")] = realtimeJitterFrames;
   if_live[F("maxbri")] = arlsForceMaxBri;
   if_live[F("no-gc")] = arlsDisableGammaCorrection;
   if_live[F("offset")] = arlsOffset;
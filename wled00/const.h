@@ -319,7 +319,7 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 //Network types (master broadcast) (80-95)
 #define TYPE_VIRTUAL_MIN         80
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
-#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGB        81            //network E131 RGB bus
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGBW     89            //network ArtNet RGB bus (master broadcast bus, unused)
@@ -499,6 +499,26 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
     #define E131_MAX_UNIVERSE_COUNT 12
   #endif
 #endif
+#ifndef SERIAL_RX_BUFFER
+  #ifdef ESP8266
+    #define SERIAL_RX_BUFFER 512   // bytes, serial receive buffer for Adalight/TPM2 data arriving between loop runs
+  #else
+    #define SERIAL_RX_BUFFER 2048
+  #endif
+#endif
+#define UDP_RECEIVE_BUDGET 3000 // us per loop spent receiving queued UDP packets (default)
+// defaults for E1.31 network busses, each bus can override them in LED settings
+#ifndef E131_OUTPUT_UNIVERSE
+  #define E131_OUTPUT_UNIVERSE 1       // first universe sent by network busses (1-63999)
+#endif
+#ifndef E131_OUTPUT_PRIORITY
+  #define E131_OUTPUT_PRIORITY 100     // priority of E1.31 data sent by network busses (0-200, 100 is the E1.31 default)
+#endif
+#ifndef E131_OUTPUT_SYNC_UNIVERSE
+  #define E131_OUTPUT_SYNC_UNIVERSE 0  // if set (1-63999), network busses send E1.31 sync packets for this universe after each frame
+#endif
+#define E131_FRAME_TIMEOUT 25 // ms after the first universe of a frame, an incomplete E1.31/Art-Net frame is shown anyway
+#define REALTIME_JITTER_MAX_FRAMES 3 // most DDP/E1.31/Art-Net frames held back by the realtime jitter buffer
 
 #ifndef ABL_MILLIAMPS_DEFAULT
   #define ABL_MILLIAMPS_DEFAULT 850   // auto lower brightness to stay close to milliampere limit
@@ -549,6 +569,15 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 //#define MIN_HEAP_SIZE
 #define MIN_HEAP_SIZE 2048
 
+// Additional JSON documents for informational responses (/json GET, WebSocket updates), allocated on first use
+// so that these do not take the global JSON buffer lock needed by control requests
+#ifdef ESP8266
+  #undef WLED_JSON_POOL_SIZE
+  #define WLED_JSON_POOL_SIZE 0 // not enough heap, and the pool relies on ESP32 heap/PSRAM helpers
+#elif !defined(WLED_JSON_POOL_SIZE)
+  #define WLED_JSON_POOL_SIZE 2
+#endif
+
 // Web server limits
 #ifdef ESP8266
 // Minimum heap to consider handling a request
@@ -647,6 +676,10 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #define HW_PIN_MISOSPI MISO
 #endif
 
+// accuracy tiers of the batch (span) math functions in wled_math.cpp
+#define MATH_EXACT 0 // same results as scalar functions
+#define MATH_FAST  1 // table/polynomial based, slightly less accurate but faster
+
 // IRAM_ATTR for 8266 with 32Kb IRAM causes error: section `.text1' will not fit in region `iram1_0_seg'
 // this hack removes the IRAM flag for some 1D/2D functions - somewhat slower, but it solves problems with some older 8266 chips
 #ifdef WLED_SAVE_IRAM
@@ -3,20 +3,156 @@
 #define MAX_3_CH_LEDS_PER_UNIVERSE 170
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
 #define MAX_CHANNELS_PER_UNIVERSE 512
+#define ARTNET_SYNC_ADDRESS 0xFFFF // sync address of Art-Net frames waiting for ArtSync (not a valid E1.31 universe)
+#define ARTNET_SYNC_TIMEOUT 4000   // ms without ArtSync after which Art-Net data is shown unsynchronized again (Art-Net 4 spec)
 
 /*
  * E1.31 handler
  */
 
+// E1.31/Art-Net frame assembly: a frame is shown once all universes it spans have arrived (or E131_FRAME_TIMEOUT passed)
+// synchronized E1.31 frames (non-zero sync address) are shown when the matching sync packet arrives, Art-Net frames when ArtSync arrives
+static uint32_t frameUniverses = 0;         // bit mask of universes received for the frame being assembled
+static uint32_t frameMissedUniverses = 0;   // universes missing from the last frame shown because of the timeout
+static unsigned long frameStart = 0;        // arrival time of the first universe of the frame being assembled
+static uint16_t frameSyncAddress = 0;       // sync universe the frame being assembled waits for (0 = not synchronized)
+static unsigned long artSyncTime = 0;       // arrival time of the last ArtSync packet
+
+// DMX mode layout, computed once per configuration instead of for every packet
+struct DMXDecoder {
+  uint8_t  mode = DMX_MODE_DISABLED; // DMXMode, DMXAddress and LED count the layout was computed for
+  uint16_t address = 0;
+  unsigned totalLen = 0;
+  bool     valid = false;
+  uint8_t  dmxLenOffset;             // 0 for legacy DMX start address 0
+  uint8_t  channelsPerLed;           // multi-pixel modes
+  uint8_t  ledsPerUniverse;          // multi-pixel modes, universes after the first
+  unsigned ledsInFirstUniverse;      // multi-pixel modes
+  uint8_t  effectChannels;           // effect modes, channels per segment
+  bool     isSegmentMode;            // effect modes, one set of channels per segment
+  unsigned universes;                // universes needed for all LEDs (at least 1)
+};
+static DMXDecoder dmxDecoder;
+
+static const DMXDecoder &getDMXDecoder() {
+  const unsigned totalLen = strip.getLengthTotal();
+  DMXDecoder &d = dmxDecoder;
+  if (d.valid && d.mode == DMXMode && d.address == DMXAddress && d.totalLen == totalLen) return d;
+
+  d.mode = DMXMode;
+  d.address = DMXAddress;
+  d.totalLen = totalLen;
+  d.dmxLenOffset = (DMXAddress == 0) ? 0 : 1;
+  const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  d.channelsPerLed = is4Chan ? 4 : 3;
+  d.ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+  const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  d.ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + d.dmxLenOffset) - dimmerOffset) / d.channelsPerLed;
+  d.effectChannels = (DMXMode == DMX_MODE_EFFECT || DMXMode == DMX_MODE_EFFECT_SEGMENT) ? 15 : 18;
+  d.isSegmentMode = (DMXMode == DMX_MODE_EFFECT_SEGMENT || DMXMode == DMX_MODE_EFFECT_SEGMENT_W);
+  d.universes = 1;
+  if ((DMXMode == DMX_MODE_MULTIPLE_DRGB || DMXMode == DMX_MODE_MULTIPLE_RGB || DMXMode == DMX_MODE_MULTIPLE_RGBW) && totalLen > d.ledsInFirstUniverse) {
+    d.universes += (totalLen - d.ledsInFirstUniverse + d.ledsPerUniverse - 1) / d.ledsPerUniverse;
+    d.universes = min(d.universes, (unsigned)E131_MAX_UNIVERSE_COUNT);
+  }
+  d.valid = true;
+  return d;
+}
+
+// number of universes needed for the LEDs in the current DMX mode (at least 1)
+static unsigned getUniverseCount() {
+  return getDMXDecoder().universes;
+}
+
+// frame state is changed by the network task (AsyncUDP on ESP32) and by handleE131FrameTimeout() in loop()
+// frames are shown (realtimeFrameReady()) after the lock is released, it takes the jitter buffer lock
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE frameMux = portMUX_INITIALIZER_UNLOCKED;
+static inline void lockFrame()   { portENTER_CRITICAL(&frameMux); }
+static inline void unlockFrame() { portEXIT_CRITICAL(&frameMux); }
+#else
+static inline void lockFrame()   {} // network callbacks do not preempt the loop
+static inline void unlockFrame() {}
+#endif
+
+// called before a universe is applied to the LEDs, previousUniverses is its index within the configured universes
+static void frameUniverseArriving(unsigned previousUniverses) {
+  const unsigned universes = getUniverseCount();
+  lockFrame();
+  const bool repeats = frameUniverses & (1UL << previousUniverses); // the previous frame is incomplete (sync packet or universes lost)
+  if (repeats) {
+    e131UniversesDropped += universes - __builtin_popcount(frameUniverses);
+    frameUniverses = 0;
+  }
+  unlockFrame();
+  if (repeats) realtimeFrameReady(); // show it before the new data overwrites its pixels
+}
+
+// called for every universe applied to the LEDs, previousUniverses is its index within the configured universes
+static void frameUniverseReceived(unsigned previousUniverses) {
+  const uint32_t universeBit = 1UL << previousUniverses;
+  const unsigned universes = getUniverseCount();
+  bool late = false, show = false;
+  lockFrame();
+  if (frameMissedUniverses & universeBit) { // belongs to the frame that was already shown
+    frameMissedUniverses &= ~universeBit;
+    late = true;
+  } else {
+    if (frameUniverses == 0) {
+      frameStart = millis();
+      frameMissedUniverses = 0;
+    }
+    frameUniverses |= universeBit;
+    show = !frameSyncAddress && (!e131WaitForFrame || __builtin_popcount(frameUniverses) >= universes); // synchronized frames wait for the sync packet
+    if (show) frameUniverses = 0;
+  }
+  unlockFrame();
+  if (late) {
+    e131UniversesLate++;
+    if (!isRealtimeFrameBuffered()) e131NewData = true; // data is already applied, show it (buffered data belongs to the next frame)
+  }
+  if (show) realtimeFrameReady();
+}
+
+// called for E1.31 sync and ArtSync packets, shows the frame being assembled if it waits for syncAddress
+static void frameSyncReceived(uint16_t syncAddress) {
+  lockFrame();
+  const bool show = frameUniverses && frameSyncAddress && frameSyncAddress == syncAddress;
+  if (show) frameUniverses = 0;
+  unlockFrame();
+  if (show) realtimeFrameReady();
+}
+
+// show incomplete frames after E131_FRAME_TIMEOUT, called from handleNotifications()
+void handleE131FrameTimeout() {
+  if (frameUniverses == 0) return; // checked again with the lock held
+  const unsigned universes = getUniverseCount();
+  bool show = false;
+  lockFrame();
+  if (frameUniverses && millis() - frameStart >= E131_FRAME_TIMEOUT) {
+    const uint32_t missing = ((1UL << universes) - 1) & ~frameUniverses;
+    if (!frameSyncAddress || missing) { // synchronized frames with all universes only missed the sync packet
+      frameMissedUniverses = missing;
+      e131UniversesDropped += __builtin_popcount(missing);
+    }
+    frameUniverses = 0;
+    show = true;
+  }
+  unlockFrame();
+  if (show) realtimeFrameReady();
+}
+
 //DDP protocol support, called by handleE131Packet
 //handles RGB data only
 void handleDDPPacket(e131_packet_t* p) {
   static bool ddpSeenPush = false;  // have we seen a push yet?
-  int lastPushSeq = e131LastSequenceNumber[0];
+  static uint8_t ddpLastPushSeq = 0; // sequence number of the last push (0 = none), separate from the E1.31 sequence numbers
+  static uint8_t ddpLastSeq = 0;     // sequence number of the last packet (0 = none)
+  int lastPushSeq = ddpLastPushSeq;
+  int sn = p->sequenceNum & 0xF;     // DDP sequence numbers are 4 bit, 0 means not used and is skipped when wrapping
 
   //reject late packets belonging to previous frame (assuming 4 packets max. before push)
   if (e131SkipOutOfSequence && lastPushSeq) {
-    int sn = p->sequenceNum & 0xF;
     if (sn) {
       if (lastPushSeq > 5) {
         if (sn > (lastPushSeq -5) && sn < lastPushSeq) return;
@@ -25,31 +161,37 @@ void handleDDPPacket(e131_packet_t* p) {
       }
     }
   }
+  if (sn && ddpLastSeq) { // count packets lost on the way
+    unsigned expectedSeq = (ddpLastSeq + 1) & 0xF;
+    if (expectedSeq == 0) expectedSeq = 1;
+    unsigned gap = (sn - expectedSeq) & 0xF;
+    if (sn < expectedSeq && gap) gap--; // wrapped past the unused 0
+    if (gap < 8) e131PacketsLost += gap; // larger gaps are late or repeated packets
+  }
+  if (sn) ddpLastSeq = sn;
 
   unsigned ddpChannelsPerLed = ((p->dataType & 0b00111000)>>3 == 0b011) ? 4 : 3; // data type 0x1B (formerly 0x1A) is RGBW (type 3, 8 bit/channel)
 
   uint32_t start =  htonl(p->channelOffset) / ddpChannelsPerLed;
   start += DMXAddress / ddpChannelsPerLed;
-  unsigned stop = start + htons(p->dataLen) / ddpChannelsPerLed;
+  unsigned count = htons(p->dataLen) / ddpChannelsPerLed;
   uint8_t* data = p->data;
-  unsigned c = 0;
-  if (p->flags & DDP_TIMECODE_FLAG) c = 4; //packet has timecode flag, we do not support it, but data starts 4 bytes later
+  uint32_t timecode = 0;
+  if (p->flags & DDP_TIMECODE_FLAG) { // sender time in 1/65536 s, paces the jitter buffer
+    timecode = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+    data += 4;
+  }
 
   if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride) {
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
-  }
+  if (!realtimeOverride) setRealtimePixels(start, data, count, ddpChannelsPerLed);
 
   bool push = p->flags & DDP_PUSH_FLAG;
   ddpSeenPush |= push;
   if (!ddpSeenPush || push) { // if we've never seen a push, or this is one, render display
-    e131NewData = true;
-    int sn = p->sequenceNum & 0xF;
-    if (sn) e131LastSequenceNumber[0] = sn;
+    realtimeFrameReady(timecode);
+    if (sn) ddpLastPushSeq = sn;
   }
 }
 
@@ -59,13 +201,23 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
   int uni = 0, dmxChannels = 0;
   uint8_t* e131_data = nullptr;
   int seq = 0, mde = REALTIME_MODE_E131;
+  uint16_t syncAddress = 0;
 
-  if (protocol == P_ARTNET)
+  if (protocol == P_E131_SYNC) {
+    frameSyncReceived(htons(p->sync_universe));
+    return;
+  } else if (protocol == P_ARTNET)
   {
     if (p->art_opcode == ARTNET_OPCODE_OPPOLL) {
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      artSyncTime = millis();
+      frameSyncReceived(ARTNET_SYNC_ADDRESS);
+      return;
+    }
+    if (artSyncTime && millis() - artSyncTime < ARTNET_SYNC_TIMEOUT) syncAddress = ARTNET_SYNC_ADDRESS; // sender uses ArtSync
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
     e131_data = p->art_data;
@@ -80,6 +232,7 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
     uni = htons(p->universe);
     e131_data = p->property_values;
     seq = p->sequence_number;
+    syncAddress = htons(p->synchronization_address);
     if (e131Priority != 0) {
       if (p->priority < e131Priority ) return;
       // track highest priority & skip all lower priorities
@@ -111,26 +264,33 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol){
       DEBUG_PRINTF_P(PSTR("skipping E1.31 frame (last seq=%d, current seq=%d, universe=%d)\n"), e131LastSequenceNumber[previousUniverses], seq, uni);
       return;
     }
+  if (seq && e131LastSequenceNumber[previousUniverses]) { // count packets lost on the way (Art-Net sequence 0 means disabled and is skipped when wrapping)
+    unsigned expectedSeq = (e131LastSequenceNumber[previousUniverses] + 1) & 0xFF;
+    if (expectedSeq == 0 && mde == REALTIME_MODE_ARTNET) expectedSeq = 1;
+    unsigned gap = (seq - expectedSeq) & 0xFF;
+    if (gap < 128) e131PacketsLost += gap; // larger gaps are late or repeated packets
+  }
   e131LastSequenceNumber[previousUniverses] = seq;
 
   // update status info
   realtimeIP = clientIP;
 
+  lockFrame();
+  frameSyncAddress = syncAddress;
+  unlockFrame();
   handleDMXData(uni, dmxChannels, e131_data, mde, previousUniverses);
 }
 
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses) {
+  const DMXDecoder &dec = getDMXDecoder();
   byte wChannel = 0;
-  unsigned totalLen = strip.getLengthTotal();
+  const unsigned totalLen = dec.totalLen;
   unsigned availDMXLen = 0;
   unsigned dataOffset = DMXAddress;
 
-  // For legacy DMX start address 0 the available DMX length offset is 0
-  const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1;
-
   // Check if DMX start address fits in available channels
   if (dmxChannels >= DMXAddress) {
-    availDMXLen = (dmxChannels - DMXAddress) + dmxLenOffset;
+    availDMXLen = (dmxChannels - DMXAddress) + dec.dmxLenOffset;
   }
 
   // DMX data in Art-Net packet starts at index 0, for E1.31 at index 1
@@ -138,7 +298,9 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
     dataOffset--;
   }
 
-  switch (DMXMode) {
+  if (mde != REALTIME_MODE_DMX) frameUniverseArriving(previousUniverses);
+
+  switch (dec.mode) {
     case DMX_MODE_DISABLED:
       return;  // nothing to do
       break;
@@ -152,8 +314,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
       if (realtimeOverride) return;
 
       wChannel = (availDMXLen > 3) ? e131_data[dataOffset+3] : 0;
-      for (unsigned i = 0; i < totalLen; i++)
-        setRealtimePixel(i, e131_data[dataOffset+0], e131_data[dataOffset+1], e131_data[dataOffset+2], wChannel);
+      fillRealtimePixels(0, totalLen, RGBW32(e131_data[dataOffset+0], e131_data[dataOffset+1], e131_data[dataOffset+2], wChannel));
       break;
 
     case DMX_MODE_SINGLE_DRGB:  // 4 channel: [Dimmer,R,G,B]
@@ -169,8 +330,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
         strip.setBrightness(bri, true);
       }
 
-      for (unsigned i = 0; i < totalLen; i++)
-        setRealtimePixel(i, e131_data[dataOffset+1], e131_data[dataOffset+2], e131_data[dataOffset+3], wChannel);
+      fillRealtimePixels(0, totalLen, RGBW32(e131_data[dataOffset+1], e131_data[dataOffset+2], e131_data[dataOffset+3], wChannel));
       break;
 
     case DMX_MODE_PRESET:       // 2 channel: [Dimmer,Preset]
@@ -204,8 +364,8 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
     case DMX_MODE_EFFECT_SEGMENT_W: // 18 Channels per segment;
       {
         if (uni != e131Universe) return;
-        bool isSegmentMode = DMXMode == DMX_MODE_EFFECT_SEGMENT || DMXMode == DMX_MODE_EFFECT_SEGMENT_W;
-        unsigned dmxEffectChannels = (DMXMode == DMX_MODE_EFFECT || DMXMode == DMX_MODE_EFFECT_SEGMENT) ? 15 : 18;
+        const bool isSegmentMode = dec.isSegmentMode;
+        const unsigned dmxEffectChannels = dec.effectChannels;
         for (unsigned id = 0; id < strip.getSegmentsNum(); id++) {
           Segment& seg = strip.getSegment(id);
           if (isSegmentMode)
@@ -268,9 +428,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
     case DMX_MODE_MULTIPLE_RGB:
     case DMX_MODE_MULTIPLE_RGBW:
       {
-        const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
-        const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
-        const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+        const unsigned dmxChannelsPerLed = dec.channelsPerLed;
         uint8_t stripBrightness = bri;
         unsigned previousLeds, dmxOffset, ledsTotal;
 
@@ -288,9 +446,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
         } else {
           // All subsequent universes start at the first channel.
           dmxOffset = (mde == REALTIME_MODE_ARTNET) ? 0 : 1;
-          const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-          unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
-          previousLeds = ledsInFirstUniverse + (previousUniverses - 1) * ledsPerUniverse;
+          previousLeds = dec.ledsInFirstUniverse + (previousUniverses - 1) * dec.ledsPerUniverse;
           ledsTotal = previousLeds + (dmxChannels / dmxChannelsPerLed);
         }
 
@@ -313,10 +469,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
           }
         }
 
-        for (unsigned i = previousLeds; i < ledsTotal; i++) {
-          setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], is4Chan ? e131_data[dmxOffset+3] : 0);
-          dmxOffset += dmxChannelsPerLed;
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, e131_data + dmxOffset, ledsTotal - previousLeds, dmxChannelsPerLed);
         break;
       }
     default:
@@ -325,7 +478,8 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
       break;
   }
 
-  e131NewData = true;
+  if (mde == REALTIME_MODE_DMX) e131NewData = true; // wired DMX input has a single universe
+  else frameUniverseReceived(previousUniverses);
 }
 
 void handleArtnetPollReply(IPAddress ipAddress) {
@@ -333,53 +487,7 @@ void handleArtnetPollReply(IPAddress ipAddress) {
   prepareArtnetPollReply(&artnetPollReply);
 
   unsigned startUniverse = e131Universe;
-  unsigned endUniverse = e131Universe;
-
-  switch (DMXMode) {
-    case DMX_MODE_DISABLED:
-      break;
-
-    case DMX_MODE_SINGLE_RGB:
-    case DMX_MODE_SINGLE_DRGB:
-    case DMX_MODE_PRESET:
-    case DMX_MODE_EFFECT:
-    case DMX_MODE_EFFECT_W:
-    case DMX_MODE_EFFECT_SEGMENT:
-    case DMX_MODE_EFFECT_SEGMENT_W:
-      break;  // 1 universe is enough
-
-    case DMX_MODE_MULTIPLE_DRGB:
-    case DMX_MODE_MULTIPLE_RGB:
-    case DMX_MODE_MULTIPLE_RGBW:
-      {
-        bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
-        const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
-        const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-        const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
-        const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
-        const unsigned totalLen = strip.getLengthTotal();
-
-        if (totalLen > ledsInFirstUniverse) {
-          const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
-          const unsigned remainLED = totalLen - ledsInFirstUniverse;
-
-          endUniverse += (remainLED / ledsPerUniverse);
-
-          if ((remainLED % ledsPerUniverse) > 0) {
-            endUniverse++;
-          }
-
-          if ((endUniverse - startUniverse) > E131_MAX_UNIVERSE_COUNT) {
-            endUniverse = startUniverse + E131_MAX_UNIVERSE_COUNT - 1;
-          }
-        }
-        break;
-      }
-    default:
-      DEBUG_PRINTLN(F("unknown E1.31 DMX mode"));
-      return;  // nothing to do
-      break;
-  }
+  unsigned endUniverse = e131Universe + getUniverseCount() - 1;
 
   if (DMXMode != DMX_MODE_DISABLED) {
     for (unsigned i = startUniverse; i <= endUniverse; ++i) {
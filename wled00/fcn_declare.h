@@ -206,6 +206,7 @@ void handleDMXInput();
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol);
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
+void handleE131FrameTimeout();
 void handleArtnetPollReply(IPAddress ipAddress);
 void prepareArtnetPollReply(ArtPollReply* reply);
 void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress);
@@ -356,11 +357,15 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=tru
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false, uint16_t universe=E131_OUTPUT_UNIVERSE, uint8_t priority=E131_OUTPUT_PRIORITY, uint16_t syncUniverse=E131_OUTPUT_SYNC_UNIVERSE);
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(unsigned i, const uint8_t *data, unsigned count, unsigned channelsPerLed);
+void fillRealtimePixels(unsigned i, unsigned count, uint32_t c);
+void realtimeFrameReady(uint32_t timecode = 0);
+bool isRealtimeFrameBuffered();
 void refreshNodeList();
 void sendSysInfoUDP();
 #ifndef WLED_DISABLE_ESPNOW
@@ -509,6 +514,8 @@ void prepareHostname(char* hostname);
 [[gnu::pure]] bool isAsterisksOnly(const char* str, byte maxLen);
 bool requestJSONBufferLock(uint8_t moduleID=255);
 void releaseJSONBufferLock();
+JsonDocument *requestJSONDocument(uint8_t moduleID=255);
+void releaseJSONDocument(JsonDocument *doc);
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -517,6 +524,7 @@ uint16_t crc16(const unsigned char* data_p, size_t length);
 uint16_t beatsin88_t(accum88 beats_per_minute_88, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase_offset = 0);
 uint16_t beatsin16_t(accum88 beats_per_minute, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase_offset = 0);
 uint8_t beatsin8_t(accum88 beats_per_minute, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phase_offset = 0);
+void beatsin8Span(uint8_t *out, size_t len, accum88 beats_per_minute, uint8_t lowest, uint8_t highest, uint32_t timebase, uint8_t phase_offset, uint8_t phase_step, uint8_t tier = MATH_EXACT); // out[i] = beatsin8_t(..., phase_offset + i*phase_step)
 um_data_t* simulateSound(uint8_t simulationId);
 void enumerateLedmaps();
 [[gnu::hot]] uint8_t get_random_wheel_index(uint8_t pos);
@@ -531,6 +539,11 @@ uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z);
 uint8_t perlin8(uint16_t x);
 uint8_t perlin8(uint16_t x, uint16_t y);
 uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z);
+void perlin16Row(uint16_t *out, unsigned len, uint32_t x, uint32_t stepX, uint32_t y);
+void perlin16Row(uint16_t *out, unsigned len, uint32_t x, uint32_t stepX, uint32_t y, uint32_t z);
+void perlin8Row(uint8_t *out, unsigned len, uint16_t x, uint16_t stepX, uint16_t y);
+void perlin8Row(uint8_t *out, unsigned len, uint16_t x, uint16_t stepX, uint16_t y, uint16_t z);
+void perlin8Grid(uint8_t *out, unsigned cols, unsigned rows, uint16_t x, uint16_t stepX, uint16_t y, uint16_t stepY, uint16_t z);
 
 // fast (true) random numbers using hardware RNG, all functions return values in the range lowerlimit to upperlimit-1
 // note: for true random numbers with high entropy, do not call faster than every 200ns (5MHz)
@@ -614,6 +627,11 @@ template <typename T> T atan_t(T x);
 float floor_t(float x);
 float fmod_t(float num, float denom);
 uint32_t sqrt32_bw(uint32_t x);
+// batch (span) variants: out[i] = f(theta + i*step) or f(x[i], y[i]), tier selects accuracy vs speed (MATH_EXACT or MATH_FAST)
+void sin8Span(uint8_t *out, size_t len, uint8_t theta, uint8_t step, uint8_t tier = MATH_EXACT);
+void cos8Span(uint8_t *out, size_t len, uint8_t theta, uint8_t step, uint8_t tier = MATH_EXACT);
+void atan2Span(uint8_t *out, const int16_t *y, const int16_t *x, size_t len, uint8_t tier = MATH_EXACT); // 0-255 per full circle
+void hypotSpan(uint16_t *out, const int16_t *x, const int16_t *y, size_t len, uint8_t tier = MATH_EXACT);
 #define sin_t sin_approx
 #define cos_t cos_approx
 #define tan_t tan_approx
@@ -762,6 +762,21 @@ void serializeInfo(JsonObject root)
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
 
+  JsonObject rt_info = root.createNestedObject(F("rt"));
+  rt_info[F("rx")] = udpPacketsReceived;      // UDP packets handled by the loop (E1.31/Art-Net/DDP are received asynchronously)
+  rt_info[F("drop")] = udpPacketsDropped;     // UDP packets discarded because of invalid size
+  rt_info[F("burst")] = udpMaxBurst;          // most UDP packets handled in one loop iteration (queue depth)
+  rt_info[F("lost")] = e131PacketsLost;       // E1.31/Art-Net/DDP packets missing according to sequence numbers
+  rt_info[F("late")] = e131UniversesLate;     // E1.31/Art-Net universes that arrived after their frame was shown
+  rt_info[F("dropped")] = e131UniversesDropped; // E1.31/Art-Net universes missing from shown frames
+  rt_info[F("jit")] = realtimeJitter;         // us average deviation of DDP/E1.31/Art-Net frame arrival from the frame interval
+  rt_info[F("lat")] = realtimeLatency;        // ms frames are held back by the jitter buffer
+
+  JsonObject json_info = root.createNestedObject(F("jbuf"));
+  json_info[F("fail")] = jsonLockFailures;   // requests refused or deferred because the global JSON buffer was in use
+  json_info[F("pool")] = jsonPoolCheckouts;  // informational responses served from a pool document
+  json_info[F("miss")] = jsonPoolMisses;     // informational responses that fell back to the global JSON buffer
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -1067,28 +1082,100 @@ void serializeModeNames(JsonArray arr)
   }
 }
 
-// Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
+// writes effect name or effect data (after '@') of a mode as quoted JSON string, dest needs 2*256+2 bytes
+// returns its length or 0 for unused modes
+static size_t modeDataJsonString(size_t mode, bool names, char *dest)
+{
+  char lineBuffer[256];
+  strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
+  lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
+  if (lineBuffer[0] == 0) return 0;
+  char* dataPtr = strchr(lineBuffer,'@');
+  const char *src = names ? lineBuffer : (dataPtr ? dataPtr+1 : "");
+  if (names && dataPtr) *dataPtr = 0; // terminate mode data after name
+  size_t len = 0;
+  dest[len++] = '"';
+  for (; *src; src++) {
+    if (*src == '"' || *src == '\\') dest[len++] = '\\';
+    dest[len++] = *src;
+  }
+  dest[len++] = '"';
+  return len;
+}
+
+// streams /json/eff or /json/fxdata straight from the mode data, the same as serializeModeNames()/serializeModeData()
+// produce but without a JsonDocument, so these large responses need neither the JSON buffer nor its lock
+static void serveModeData(AsyncWebServerRequest* request, bool names)
+{
+  struct {
+    bool names;
+    size_t mode;
+    bool first;
+    char item[2*256+3]; // separator and quoted string
+    size_t itemLen, itemPos;
+  } writer = {names, 0, true, {0}, 0, 0};
+
+  size_t length = 2; // []
+  size_t items = 0;
+  for (size_t i = 0; i < strip.getModeCount(); i++) {
+    size_t len = modeDataJsonString(i, names, writer.item);
+    if (len) { length += len; items++; }
+  }
+  if (items > 1) length += items - 1; // separators
+
+  AsyncWebServerResponse *response = request->beginResponse(FPSTR(CONTENT_TYPE_JSON), length,
+    [writer](uint8_t *buf, size_t maxLen, size_t) mutable -> size_t {
+      size_t n = 0;
+      while (n < maxLen) {
+        if (writer.itemPos == writer.itemLen) { // generate next item
+          const size_t count = strip.getModeCount();
+          if (writer.mode > count) break; // done
+          writer.itemPos = writer.itemLen = 0;
+          while (writer.mode < count && !writer.itemLen) {
+            writer.itemLen = modeDataJsonString(writer.mode++, writer.names, writer.item+1);
+          }
+          if (writer.itemLen) {
+            writer.item[0] = writer.first ? '[' : ',';
+            writer.itemLen++;
+            writer.first = false;
+          } else { // after the last mode
+            if (writer.first) writer.item[writer.itemLen++] = '[';
+            writer.item[writer.itemLen++] = ']';
+            writer.mode = count+1;
+          }
+        }
+        size_t len = min(maxLen - n, writer.itemLen - writer.itemPos);
+        memcpy(buf + n, writer.item + writer.itemPos, len);
+        n += len;
+        writer.itemPos += len;
+      }
+      return n;
+    });
+  request->send(response);
+}
+
+// JSON document locking response helper class (to make sure the document is released when AsyncJsonResponse is destroyed)
 class LockedJsonResponse: public AsyncJsonResponse {
+  JsonDocument *_doc;
   bool _holding_lock;
   public:
-  // WARNING: constructor assumes requestJSONBufferLock() was successfully acquired externally/prior to constructing the instance
+  // WARNING: constructor assumes doc was successfully acquired by requestJSONDocument() prior to constructing the instance
   // Not a good practice with C++. Unfortunately AsyncJsonResponse only has 2 constructors - for dynamic buffer or existing buffer,
   // with existing buffer it clears its content during construction
-  // if the lock was not acquired (using JSONBufferGuard class) previous implementation still cleared existing buffer
-  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _holding_lock(true) {};
+  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _doc(doc), _holding_lock(true) {};
 
   virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) { 
     size_t result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
     // Release lock as soon as we're done filling content
     if (((result + _sentLength) >= (_contentLength)) && _holding_lock) {
-      releaseJSONBufferLock();
+      releaseJSONDocument(_doc);
       _holding_lock = false;
     }
     return result;
   }
 
-  // destructor will remove JSON buffer lock when response is destroyed in AsyncWebServer
-  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
+  // destructor will release the JSON document when response is destroyed in AsyncWebServer
+  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONDocument(_doc); };
 };
 
 void serveJson(AsyncWebServerRequest* request)
@@ -1123,13 +1210,19 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  if (!requestJSONBufferLock(17)) {
+  if (subJson == json_target::effects || subJson == json_target::fxdata) {
+    serveModeData(request, subJson == json_target::effects);
+    return;
+  }
+
+  JsonDocument *doc = requestJSONDocument(17);
+  if (!doc) {
     request->deferResponse();    
     return;
   }
-  // releaseJSONBufferLock() will be called when "response" is destroyed (from AsyncWebServer)
+  // releaseJSONDocument() will be called when "response" is destroyed (from AsyncWebServer)
   // make sure you delete "response" if no "request->send(response);" is made
-  LockedJsonResponse *response = new LockedJsonResponse(pDoc, subJson==json_target::fxdata || subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
+  LockedJsonResponse *response = new LockedJsonResponse(doc, false); // will clear the JsonDocument
 
   JsonVariant lDoc = response->getRoot();
 
@@ -1143,14 +1236,13 @@ void serveJson(AsyncWebServerRequest* request)
       serializeNodes(lDoc); break;
     case json_target::palettes:
       serializePalettes(lDoc, request->hasParam(F("page")) ? request->getParam(F("page"))->value().toInt() : 0); break;
-    case json_target::effects:
-      serializeModeNames(lDoc); break;
-    case json_target::fxdata:
-      serializeModeData(lDoc); break;
     case json_target::networks:
       serializeNetworks(lDoc); break;
     case json_target::config:
       serializeConfig(lDoc); break;
+    case json_target::effects:
+    case json_target::fxdata:
+      break; // streamed by serveModeData()
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
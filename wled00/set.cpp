@@ -174,6 +174,9 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       char sp[4] = "SP"; sp[2] = offset+s; sp[3] = 0; //bus clock speed (DotStar & PWM)
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED mA
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max mA
+      char eu[4] = "EU"; eu[2] = offset+s; eu[3] = 0; //E1.31 start universe
+      char ep[4] = "EP"; ep[2] = offset+s; ep[3] = 0; //E1.31 priority
+      char es[4] = "ES"; es[2] = offset+s; es[3] = 0; //E1.31 sync universe
       if (!request->hasArg(lp)) {
         DEBUG_PRINTF_P(PSTR("# of buses: %d\n"), s+1);
         break;
@@ -223,10 +226,13 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
         maPerLed = request->arg(la).toInt();
         maMax = request->arg(ma).toInt() * request->hasArg(F("PPL")); // if PP-ABL is disabled maMax (per bus) must be 0
       }
+      uint16_t e131Uni  = request->hasArg(eu) ? request->arg(eu).toInt() : E131_OUTPUT_UNIVERSE;
+      uint8_t  e131Prio = request->hasArg(ep) ? request->arg(ep).toInt() : E131_OUTPUT_PRIORITY;
+      uint16_t e131Sync = request->hasArg(es) ? request->arg(es).toInt() : E131_OUTPUT_SYNC_UNIVERSE;
       type |= request->hasArg(rf) << 7; // off refresh override
       // actual finalization is done in WLED::loop() (removing old busses and adding new)
       // this may happen even before this loop is finished so we do "doInitBusses" after the loop
-      busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, maPerLed, maMax);
+      busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, maPerLed, maMax, e131Uni, e131Prio, e131Sync);
       busesChanged = true;
     }
     //doInitBusses = busesChanged; // we will do that below to ensure all input data is processed
@@ -415,6 +421,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     useMainSegmentOnly = request->hasArg(F("MO"));
     realtimeRespectLedMaps = request->hasArg(F("RLM"));
     e131SkipOutOfSequence = request->hasArg(F("ES"));
+    e131WaitForFrame = request->hasArg(F("EW"));
     e131Multicast = request->hasArg(F("EM"));
     t = request->arg(F("EP")).toInt();
     if (t > 0) e131Port = t;
@@ -430,6 +437,8 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     if (t >= DMX_MODE_DISABLED && t <= DMX_MODE_PRESET) DMXMode = t;
     t = request->arg(F("ET")).toInt();
     if (t > 99  && t <= 65000) realtimeTimeoutMs = t;
+    t = request->arg(F("JB")).toInt();
+    if (t >= 0  && t <= REALTIME_JITTER_MAX_FRAMES) realtimeJitterFrames = t;
     arlsForceMaxBri = request->hasArg(F("FB"));
     arlsDisableGammaCorrection = request->hasArg(F("RG"));
     t = request->arg(F("WO")).toInt();
@@ -485,7 +494,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     #endif
 
     t = request->arg(F("BD")).toInt();
-    if (t >= 96 && t <= 15000) serialBaud = t;
+    if (t >= 96 && t <= 30000) serialBaud = t;
     updateBaudRate(serialBaud *100);
   }
 
@@ -59,10 +59,14 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
 
 #define P_E131   0
 #define P_ARTNET 1
 #define P_DDP    2
+#define P_E131_SYNC 3 // E1.31 synchronization packet
+
+#define E131_SYNC_PACKET_SIZE 49
 
 // E1.31 Packet Offsets
 #define E131_ROOT_PREAMBLE_SIZE 0
@@ -105,7 +109,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t synchronization_address; // universe of the sync packets this data waits for, 0 = not synchronized (reserved in E1.31-2009)
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -132,6 +136,15 @@ typedef union {
     uint8_t  art_data[512];
   } __attribute__((packed));
 
+  struct { //E1.31 synchronization packet (same root layer as data packet)
+    uint8_t  sync_root_layer[38];
+    uint16_t sync_flength;
+    uint32_t sync_vector;
+    uint8_t  sync_sequence_number;
+    uint16_t sync_universe;
+    uint16_t sync_reserved;
+  } __attribute__((packed));
+
   struct { //DDP Header
     uint8_t flags;
     uint8_t sequenceNum;
@@ -208,6 +221,8 @@ class ESPAsyncE131 {
 	  static const uint8_t ART_ID[];
     static const uint32_t VECTOR_ROOT = 4;
     static const uint32_t VECTOR_FRAME = 2;
+    static const uint32_t VECTOR_ROOT_EXTENDED = 8;
+    static const uint32_t VECTOR_EXTENDED_SYNC = 1;
     static const uint8_t VECTOR_DMP = 2;
 
     AsyncUDP        udp;        // AsyncUDP
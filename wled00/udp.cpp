@@ -1,4 +1,10 @@
 #include "wled.h"
+#ifdef ARDUINO_ARCH_ESP32
+  #include <atomic>
+  #include "mbedtls/sha1.h"
+#else
+  #include <Hash.h>
+#endif
 
 /*
  * UDP sync notifier / Realtime / Hyperion / TPM2.NET
@@ -465,15 +471,170 @@ void sendTPM2Ack() {
 }
 
 
+/*
+ * Realtime jitter buffer
+ * DDP/E1.31/Art-Net frames are written to a ring of frame buffers instead of the LEDs and shown from the loop at the
+ * average frame interval, trading realtimeJitterFrames frames of latency for even output timing.
+ * Only the receiving side advances jitterWritten and only the loop advances jitterShown.
+ * On ESP32 the receiving side runs in the network task. It pins the ring and writes the current frame without a lock,
+ * the loop never reads that frame and waits for pinned writers before freeing the ring. Only publishing a completed
+ * frame (advancing jitterWritten) holds jitterMux. Without a ring, realtime data goes straight to the LEDs unlocked.
+ */
+static uint32_t *jitterFrames = nullptr;     // jitterSlots frames of jitterLength pixels
+static unsigned jitterLength = 0;
+static unsigned jitterSlots = 0;             // realtimeJitterFrames + the frame being received
+static volatile unsigned jitterWritten = 0;  // frames completed by the sender
+static volatile unsigned jitterShown = 0;    // frames copied to the LEDs
+static bool jitterStarted = false;           // buffer has filled up, frames are being shown
+static unsigned long jitterNextShow = 0;     // us
+static unsigned long jitterLastArrival = 0;  // us
+static uint32_t jitterLastTimecode = 0;      // DDP timecode of the last frame (0 = none)
+static uint32_t jitterPeriod = 0;            // us, average frame interval
+#ifdef ARDUINO_ARCH_ESP32
+static portMUX_TYPE jitterMux = portMUX_INITIALIZER_UNLOCKED;
+static std::atomic<unsigned> jitterWriters{0}; // senders writing to the pinned ring
+static inline void lockJitterBuffer()   { portENTER_CRITICAL(&jitterMux); }
+static inline void unlockJitterBuffer() { portEXIT_CRITICAL(&jitterMux); }
+static inline void pinJitterBuffer()    { jitterWriters++; }
+static inline void unpinJitterBuffer()  { jitterWriters--; }
+static inline void waitJitterWriters()  { while (jitterWriters) delay(1); } // a sender writes at most one packet of pixels
+#else
+static inline void lockJitterBuffer()   {} // network callbacks do not preempt the loop
+static inline void unlockJitterBuffer() {}
+static inline void pinJitterBuffer()    {}
+static inline void unpinJitterBuffer()  {}
+static inline void waitJitterWriters()  {}
+#endif
+
+static bool isJitterBufferedMode() {
+  return realtimeMode == REALTIME_MODE_E131 || realtimeMode == REALTIME_MODE_ARTNET || realtimeMode == REALTIME_MODE_DDP;
+}
+
+// true if completed realtime frames are queued in the jitter buffer instead of being shown right away
+bool isRealtimeFrameBuffered() {
+  return jitterFrames && isJitterBufferedMode();
+}
+
+// pins the ring for the sender, nullptr (nothing pinned) if realtime data goes straight to the LEDs
+// call unpinJitterBuffer() when done writing to a pinned ring
+static uint32_t *pinJitterFrames() {
+  if (!jitterFrames || !isJitterBufferedMode()) return nullptr; // no ring: no pin
+  pinJitterBuffer();
+  uint32_t *frames = __atomic_load_n(&jitterFrames, __ATOMIC_SEQ_CST); // the loop may have freed it meanwhile
+  if (!frames) unpinJitterBuffer();
+  return frames;
+}
+
+// frame currently written by the sender, nullptr (nothing pinned) if realtime data goes straight to the LEDs
+// call unpinJitterBuffer() when done writing to a returned frame
+static uint32_t *getJitterWriteFrame(unsigned &len) {
+  uint32_t *frames = pinJitterFrames();
+  if (!frames) return nullptr;
+  len = jitterLength;
+  return frames + (jitterWritten % jitterSlots) * jitterLength;
+}
+
+static void freeJitterBuffer() {
+  uint32_t *frames = jitterFrames;
+  __atomic_store_n(&jitterFrames, nullptr, __ATOMIC_SEQ_CST);
+  waitJitterWriters(); // a sender may still write to the ring it pinned
+  d_free(frames);
+  jitterStarted = false;
+  jitterLastArrival = 0;
+  jitterLastTimecode = 0;
+  jitterPeriod = 0;
+  realtimeLatency = 0;
+}
+
+// called by the E1.31/Art-Net/DDP handlers once a frame is complete, timecode is the DDP sender time (0 = none)
+void realtimeFrameReady(uint32_t timecode) {
+  uint32_t *frames = pinJitterFrames();
+  if (!frames) {
+    e131NewData = true;
+    return;
+  }
+  unsigned long now = micros();
+  uint32_t interval = now - jitterLastArrival;
+  if (jitterLastArrival && interval < 1000000) { // ignore pauses in the stream
+    // the timecode holds the interval intended by the sender, arrival times include network jitter
+    uint32_t period = (timecode && jitterLastTimecode) ? ((uint64_t)(timecode - jitterLastTimecode) * 1000000) >> 16 : interval;
+    if (!jitterPeriod) jitterPeriod = period;
+    else               jitterPeriod = (int32_t)jitterPeriod + ((int32_t)period - (int32_t)jitterPeriod) / 8;
+    int32_t deviation = abs((int32_t)interval - (int32_t)jitterPeriod);
+    realtimeJitter = (int32_t)realtimeJitter + (deviation - (int32_t)realtimeJitter) / 8;
+  }
+  jitterLastArrival = now;
+  jitterLastTimecode = timecode;
+
+  const unsigned written = jitterWritten;
+  if (written - jitterShown < jitterSlots - 1) { // if the buffer is full the next frame overwrites this one
+    const uint32_t *frame = frames + (written % jitterSlots) * jitterLength;
+    uint32_t *next = frames + ((written + 1) % jitterSlots) * jitterLength;
+    memcpy(next, frame, jitterLength * sizeof(uint32_t)); // senders may update only part of the LEDs
+    lockJitterBuffer();
+    if (jitterWritten == written) jitterWritten = written + 1; // publish, unless the loop (E1.31 frame timeout) did meanwhile
+    unlockJitterBuffer();
+  }
+  unpinJitterBuffer();
+}
+
+// shows buffered realtime frames at a steady pace, called from handleNotifications()
+static void handleJitterBuffer() {
+  unsigned len;
+  uint32_t *pixels = strip.getRealtimePixels(len);
+  const bool wanted = realtimeJitterFrames && isJitterBufferedMode() && pixels;
+  if (jitterFrames && (!wanted || len != jitterLength || jitterSlots != realtimeJitterFrames + 1U)) freeJitterBuffer();
+  if (!wanted) return;
+
+  if (!jitterFrames) {
+    uint32_t *frames = static_cast<uint32_t*>(d_malloc((realtimeJitterFrames + 1) * len * sizeof(uint32_t)));
+    if (!frames) return; // not enough memory, frames go straight to the LEDs
+    memcpy(frames, pixels, len * sizeof(uint32_t));
+    jitterSlots = realtimeJitterFrames + 1;
+    jitterLength = len;
+    jitterWritten = jitterShown = 0;
+    __atomic_store_n(&jitterFrames, frames, __ATOMIC_SEQ_CST); // senders see the ring only once it is set up
+    return;
+  }
+
+  const unsigned queued = jitterWritten - jitterShown;
+  unsigned long now = micros();
+  if (!jitterStarted) {
+    if (queued < realtimeJitterFrames) return; // still filling up
+    jitterStarted = true;
+    jitterNextShow = now;
+  }
+  if (queued == 0) { // ran empty, fill up again before showing
+    jitterStarted = false;
+    return;
+  }
+  if ((long)(now - jitterNextShow) < 0) return;
+
+  memcpy(pixels, jitterFrames + (jitterShown % jitterSlots) * jitterLength, jitterLength * sizeof(uint32_t));
+  jitterShown++;
+  if (useMainSegmentOnly) strip.trigger();
+  else                    strip.show();
+
+  // pace at the average frame interval, slightly faster or slower to keep the buffer at its target depth
+  uint32_t period = jitterPeriod;
+  if      (queued > realtimeJitterFrames) period -= period / 16;
+  else if (queued < realtimeJitterFrames) period += period / 16;
+  jitterNextShow += period;
+  if ((long)(now - jitterNextShow) > (long)period) jitterNextShow = now + period; // fell behind, do not catch up in a burst
+  realtimeLatency = (queued * jitterPeriod + 500) / 1000;
+}
+
+static bool handleUdpPacket();
+
 void handleNotifications()
 {
-  IPAddress localIP;
-
   //send second notification if enabled
   if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
     notify(notificationSentCallMode,true);
   }
 
+  handleE131FrameTimeout();
+  handleJitterBuffer();
   if (e131NewData && millis() - strip.getLastShow() > 15)
   {
     e131NewData = false;
@@ -484,9 +645,22 @@ void handleNotifications()
   //unlock strip when realtime UDP times out
   if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
 
-  //receive UDP notifications
+  //receive UDP notifications, drain all queued packets within the time budget
   if (!udpConnected) return;
+  unsigned long startTime = micros();
+  unsigned packets = 0;
+  while (handleUdpPacket()) {
+    packets++;
+    if (micros() - startTime > udpReceiveBudget) break;
+  }
+  udpPacketsReceived += packets;
+  if (packets > udpMaxBurst) udpMaxBurst = packets;
+}
 
+// handles one packet received on the notifier or raw RGB port, returns false if no packet was pending
+static bool handleUdpPacket()
+{
+  IPAddress localIP;
   bool isSupp = false;
   size_t packetSize = notifierUdp.parsePacket();
   if (!packetSize && udp2Connected) {
@@ -498,28 +672,26 @@ void handleNotifications()
   if (!packetSize && udpRgbConnected) {
     packetSize = rgbUdp.parsePacket();
     if (packetSize) {
-      if (!receiveDirect) return;
-      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;
+      if (!receiveDirect) return true;
+      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) { udpPacketsDropped++; return true; }
       realtimeIP = rgbUdp.remoteIP();
       DEBUG_PRINTLN(rgbUdp.remoteIP());
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
-      if (realtimeOverride) return;
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-      }
+      if (realtimeOverride) return true;
+      setRealtimePixels(0, lbuf, packetSize / 3, 3);
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
-      return;
+      return true;
     }
   }
 
   localIP = Network.localIP();
   //notifier and UDP realtime
-  if (!packetSize || packetSize > UDP_IN_MAXSIZE) return;
-  if (!isSupp && notifierUdp.remoteIP() == localIP) return; //don't process broadcasts we send ourselves
+  if (!packetSize) return false; // nothing received
+  if (packetSize > UDP_IN_MAXSIZE) { udpPacketsDropped++; return true; }
+  if (!isSupp && notifierUdp.remoteIP() == localIP) return true; //don't process broadcasts we send ourselves
 
   uint8_t udpIn[packetSize +1];
   unsigned len;
@@ -528,7 +700,7 @@ void handleNotifications()
 
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
-    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return;
+    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return true;
 
     unsigned unit = udpIn[39];
     NodesMap::iterator it = Nodes.find(unit);
@@ -554,7 +726,7 @@ void handleNotifications()
           build |= udpIn[40+i]<<(8*i);
       it->second.build = build;
     }
-    return;
+    return true;
   }
 
   //wled notifier, ignore if realtime packets active
@@ -562,10 +734,10 @@ void handleNotifications()
   {
     DEBUG_PRINTF_P(PSTR("UDP notification from: %d.%d.%d.%d\n"), notifierUdp.remoteIP()[0], notifierUdp.remoteIP()[1], notifierUdp.remoteIP()[2], notifierUdp.remoteIP()[3]);
     parseNotifyPacket(udpIn);
-    return;
+    return true;
   }
 
-  if (!receiveDirect) return;
+  if (!receiveDirect) return true;
 
   //TPM2.NET
   if (udpIn[0] == 0x9c)
@@ -574,13 +746,13 @@ void handleNotifications()
     //if the number of LEDs in your installation doesn't allow that, please include padding bytes at the end of the last packet
     byte tpmType = udpIn[1];
     if (tpmType == 0xaa) { //TPM2.NET polling, expect answer
-      sendTPM2Ack(); return;
+      sendTPM2Ack(); return true;
     }
-    if (tpmType != 0xda) return; //return if notTPM2.NET data
+    if (tpmType != 0xda) return true; //return if notTPM2.NET data
 
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
-    if (realtimeOverride) return;
+    if (realtimeOverride) return true;
 
     tpmPacketCount++; //increment the packet count
     if (tpmPacketCount == 1) tpmPayloadFrameSize = (udpIn[2] << 8) + udpIn[3]; //save frame size for the whole payload if this is the first packet
@@ -588,16 +760,13 @@ void handleNotifications()
     byte numPackets = udpIn[5];
 
     unsigned id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-    unsigned totalLen = strip.getLengthTotal();
-    for (size_t i = 6; i < tpmPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-      setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-    }
+    setRealtimePixels(id, udpIn + 6, tpmPayloadFrameSize / 3, 3);
     if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
       tpmPacketCount = 0;
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
     }
-    return;
+    return true;
   }
 
   //UDP realtime: 1 warls 2 drgb 3 drgbw
@@ -605,15 +774,15 @@ void handleNotifications()
   {
     realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
     DEBUG_PRINTLN(realtimeIP);
-    if (packetSize < 2) return;
+    if (packetSize < 2) return true;
 
     if (udpIn[1] == 0) {
       realtimeTimeout = 0; // cancel realtime mode immediately
-      return;
+      return true;
     } else {
       realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
     }
-    if (realtimeOverride) return;
+    if (realtimeOverride) return true;
 
     unsigned totalLen = strip.getLengthTotal();
     if (udpIn[0] == 1 && packetSize > 5) //warls
@@ -624,23 +793,14 @@ void handleNotifications()
       }
     } else if (udpIn[0] == 2 && packetSize > 4) //drgb
     {
-      for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 3, 3);
     } else if (udpIn[0] == 3 && packetSize > 6) //drgbw
     {
-      for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-      }
+      setRealtimePixels(0, udpIn + 2, (packetSize - 2) / 4, 4);
     } else if (udpIn[0] == 4 && packetSize > 7) //dnrgb
     {
       unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-      for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++)
-      {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      setRealtimePixels(id, udpIn + 4, (packetSize - 4) / 3, 3);
     } else if (udpIn[0] == 5 && packetSize > 8) //dnrgbw
     {
       unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
@@ -651,7 +811,7 @@ void handleNotifications()
     }
     if (useMainSegmentOnly) strip.trigger();
     else                    strip.show();
-    return;
+    return true;
   }
 
   // API over UDP
@@ -669,15 +829,72 @@ void handleNotifications()
     }
     releaseJSONBufferLock();
   }
+  return true;
 }
 
 
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
 {
   unsigned pix = i + arlsOffset;
+  unsigned len;
+  uint32_t *frame = getJitterWriteFrame(len);
+  if (frame) {
+    if (pix < len) frame[pix] = RGBW32(r,g,b,w);
+    unpinJitterBuffer();
+    return;
+  }
   strip.setRealtimePixelColor(pix, RGBW32(r,g,b,w));
 }
 
+// realtime target of count pixels starting at LED i (shifted by arlsOffset), nullptr if none of them exist
+// count is clipped to the target, skip returns the number of pixels shifted out below the start
+// pinned is set if the target is a jitter buffer frame, call unpinJitterBuffer() when done writing to it
+static uint32_t *getRealtimeSpan(unsigned i, unsigned &count, unsigned &skip, bool &pinned)
+{
+  unsigned len;
+  uint32_t *pixels = getJitterWriteFrame(len);
+  pinned = pixels;
+  if (!pixels) pixels = strip.getRealtimePixels(len);
+  int pix = (int)i + arlsOffset;
+  skip = 0;
+  if (!pixels || pix >= (int)len) return nullptr;
+  if (pix < 0) {
+    if ((unsigned)-pix >= count) return nullptr;
+    skip = -pix;
+    count -= skip;
+    pix = 0;
+  }
+  count = min(count, len - pix);
+  return pixels + pix;
+}
+
+// bulk version of setRealtimePixel(): writes count pixels of RGB (3 channels) or RGBW (4 channels) data starting at LED i
+void setRealtimePixels(unsigned i, const uint8_t *data, unsigned count, unsigned channelsPerLed)
+{
+  unsigned skip;
+  bool pinned;
+  uint32_t *dst = getRealtimeSpan(i, count, skip, pinned);
+  if (dst) {
+    data += skip * channelsPerLed;
+    if (channelsPerLed == 4) {
+      for (unsigned n = 0; n < count; n++, data += 4) dst[n] = RGBW32(data[0], data[1], data[2], data[3]);
+    } else {
+      for (unsigned n = 0; n < count; n++, data += 3) dst[n] = RGBW32(data[0], data[1], data[2], 0);
+    }
+  }
+  if (pinned) unpinJitterBuffer();
+}
+
+// sets count pixels starting at LED i to the same color
+void fillRealtimePixels(unsigned i, unsigned count, uint32_t c)
+{
+  unsigned skip;
+  bool pinned;
+  uint32_t *dst = getRealtimeSpan(i, count, skip, pinned);
+  if (dst) for (unsigned n = 0; n < count; n++) dst[n] = c;
+  if (pinned) unpinJitterBuffer();
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -791,10 +1008,70 @@ static       size_t sequenceNumber = 0; // this needs to be shared across all ou
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
 
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW)  {
+// DDP and Art-Net packets are assembled here and sent with a single write
+static byte udpOutPacket[DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET];
+
+// copies channel data into a packet, applying brightness
+static void scaleChannels(byte *dst, const byte *src, size_t len, uint8_t bri) {
+  if (bri == 255) {
+    memcpy(dst, src, len);
+    return;
+  }
+  const unsigned scale = bri + 1; // same as scale8(): (c * (bri+1)) >> 8
+  for (size_t i = 0; i < len; i++) dst[i] = (src[i] * scale) >> 8;
+}
+
+// E1.31 output: data packets are assembled in a template whose constant fields (root layer, CID, DMP layer) are filled once
+static const size_t E131_HEADER_SIZE = 126; // up to and including the DMX start code
+static const byte   E131_ACN_ID[] PROGMEM = {0x41,0x53,0x43,0x2d,0x45,0x31,0x2e,0x31,0x37,0x00,0x00,0x00}; // "ASC-E1.17"
+static const byte   E131_CID_NAMESPACE[] PROGMEM = {0x46,0x24,0xa6,0x12,0x67,0xe0,0x4b,0xf0,0x9b,0x8b,0x39,0x3a,0xa6,0xc5,0xba,0x01}; // name space of WLED CIDs (random UUID)
+static byte         e131Packet[E131_HEADER_SIZE + 512];
+static byte         e131SyncPacket[E131_SYNC_PACKET_SIZE];
+static uint8_t      e131SequenceNumber = 0; // every universe (and the sync packet) is sent once per frame, so one counter advances each of them by 1
+
+static inline void writeE131Length(byte *p, size_t length) { // flags (0x7) and 12 bit PDU length
+  p[0] = 0x70 | ((length >> 8) & 0x0F);
+  p[1] = length & 0xFF;
+}
+
+// CID is a name based (version 5, RFC 4122) UUID of the MAC address, so it stays the same across reboots
+static void getE131CID(byte *cid) {
+  byte name[sizeof(E131_CID_NAMESPACE) + 6];
+  byte hash[20];
+  memcpy_P(name, E131_CID_NAMESPACE, sizeof(E131_CID_NAMESPACE));
+  WiFi.macAddress(name + sizeof(E131_CID_NAMESPACE));
+  #ifdef ARDUINO_ARCH_ESP32
+  mbedtls_sha1_ret(name, sizeof(name), hash);
+  #else
+  sha1(name, sizeof(name), hash);
+  #endif
+  memcpy(cid, hash, 16);
+  cid[6] = (cid[6] & 0x0F) | 0x50; // version 5
+  cid[8] = (cid[8] & 0x3F) | 0x80; // RFC 4122 variant
+}
+
+static void initE131Templates() {
+  memset(e131Packet, 0, E131_HEADER_SIZE);
+  e131Packet[1] = 0x10; // preamble size
+  memcpy_P(e131Packet + 4, E131_ACN_ID, sizeof(E131_ACN_ID));
+  e131Packet[21] = 0x04; // root vector: E1.31 data
+  getE131CID(e131Packet + 22);
+  e131Packet[43] = 0x02; // framing vector: DMP data
+  e131Packet[117] = 0x02; // DMP vector: set property
+  e131Packet[118] = 0xA1; // address & data type
+  e131Packet[122] = 0x01; // address increment
+  // sync packet shares the root layer except for its vector and length
+  memcpy(e131SyncPacket, e131Packet, 38);
+  e131SyncPacket[21] = 0x08; // root vector: E1.31 extended
+  writeE131Length(e131SyncPacket + 16, E131_SYNC_PACKET_SIZE - 16);
+  writeE131Length(e131SyncPacket + 38, E131_SYNC_PACKET_SIZE - 38);
+  e131SyncPacket[43] = 0x01; // framing vector: synchronization
+}
+
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW, uint16_t universe, uint8_t priority, uint16_t syncUniverse)  {
   if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
 
-  WiFiUDP ddpUdp;
+  static WiFiUDP ddpUdp; // kept between calls (ESP32 creates its socket on first use)
 
   switch (type) {
     case 0: // DDP
@@ -805,17 +1082,10 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 
       // there are 3 channels per RGB pixel
       uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
 
       for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
         if (sequenceNumber > 15) sequenceNumber = 0;
 
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
         // the amount of data is AFTER the header in the current packet
         size_t packetSize = DDP_CHANNELS_PER_PACKET;
 
@@ -830,28 +1100,26 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
         }
 
         // write the header
-        /*0*/ddpUdp.write(flags);
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
+        /*0*/udpOutPacket[0] = flags;
+        /*1*/udpOutPacket[1] = sequenceNumber++ & 0x0F; // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
+        /*2*/udpOutPacket[2] = isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+        /*3*/udpOutPacket[3] = DDP_ID_DISPLAY;
         // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
+        /*4*/udpOutPacket[4] = 0xFF & (channel >> 24);
+        /*5*/udpOutPacket[5] = 0xFF & (channel >> 16);
+        /*6*/udpOutPacket[6] = 0xFF & (channel >>  8);
+        /*7*/udpOutPacket[7] = 0xFF & (channel      );
         // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        /*8*/udpOutPacket[8] = 0xFF & (packetSize >> 8);
+        /*9*/udpOutPacket[9] = 0xFF & (packetSize     );
+
+        scaleChannels(udpOutPacket + DDP_HEADER_LEN, buffer + channel, packetSize, bri);
 
+        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
+          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
+          return 1; // problem
+        }
+        ddpUdp.write(udpOutPacket, DDP_HEADER_LEN + packetSize);
         if (!ddpUdp.endPacket()) {
           //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
           return 1; // problem
@@ -863,6 +1131,63 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 
     case 1: //E1.31
     {
+      static bool e131TemplatesInited = false;
+      if (!e131TemplatesInited) {
+        initE131Templates();
+        e131TemplatesInited = true;
+      }
+      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
+      const size_t E131_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+      const size_t packetCount = ((channelCount-1)/E131_CHANNELS_PER_PACKET)+1;
+      size_t bufferOffset = 0;
+
+      e131SequenceNumber++; // wraps at 255 as E1.31 expects, independent of the DDP and Art-Net counter
+
+      // fields that differ between busses or can change at runtime (source name is the server description)
+      strncpy((char*)e131Packet + 44, serverDescription, 63); // zero padded, byte 107 stays 0
+      e131Packet[108] = priority;
+      e131Packet[109] = (syncUniverse >> 8) & 0xFF;
+      e131Packet[110] = syncUniverse & 0xFF;
+
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+        size_t packetSize = E131_CHANNELS_PER_PACKET;
+        if (currentPacket == (packetCount - 1U) && (channelCount % E131_CHANNELS_PER_PACKET)) {
+          packetSize = channelCount % E131_CHANNELS_PER_PACKET; // last packet
+        }
+        const size_t totalSize = E131_HEADER_SIZE + packetSize;
+        const unsigned packetUniverse = universe + currentPacket;
+        if (packetUniverse > 63999) break; // highest valid E1.31 universe
+
+        writeE131Length(e131Packet + 16, totalSize - 16);  // root layer length
+        writeE131Length(e131Packet + 38, totalSize - 38);  // framing layer length
+        e131Packet[111] = e131SequenceNumber;
+        e131Packet[113] = (packetUniverse >> 8) & 0xFF;
+        e131Packet[114] = packetUniverse & 0xFF;
+        writeE131Length(e131Packet + 115, totalSize - 115); // DMP layer length
+        e131Packet[123] = ((packetSize + 1) >> 8) & 0xFF;  // property value count includes the start code
+        e131Packet[124] = (packetSize + 1) & 0xFF;
+        scaleChannels(e131Packet + E131_HEADER_SIZE, buffer + bufferOffset, packetSize, bri);
+        bufferOffset += packetSize;
+
+        if (!ddpUdp.beginPacket(client, E131_DEFAULT_PORT)) {
+          DEBUG_PRINTLN(F("E1.31 WiFiUDP.beginPacket returned an error"));
+          return 1; // borked
+        }
+        ddpUdp.write(e131Packet, totalSize);
+        if (!ddpUdp.endPacket()) {
+          DEBUG_PRINTLN(F("E1.31 WiFiUDP.endPacket returned an error"));
+          return 1; // borked
+        }
+      }
+
+      if (syncUniverse) { // receivers hold the frame until the sync packet arrives
+        e131SyncPacket[44] = e131SequenceNumber;
+        e131SyncPacket[45] = (syncUniverse >> 8) & 0xFF;
+        e131SyncPacket[46] = syncUniverse & 0xFF;
+        if (!ddpUdp.beginPacket(client, E131_DEFAULT_PORT)) return 1;
+        ddpUdp.write(e131SyncPacket, E131_SYNC_PACKET_SIZE);
+        if (!ddpUdp.endPacket()) return 1;
+      }
     } break;
 
     case 2: //ArtNet
@@ -873,19 +1198,16 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
       const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
 
       uint32_t channel = 0; 
-      size_t bufferOffset = 0;
 
       sequenceNumber++;
+      if (sequenceNumber > 255) sequenceNumber = 0;
 
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
+      memcpy_P(udpOutPacket, ART_NET_HEADER, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
+      udpOutPacket[12] = sequenceNumber & 0xFF; // sequence number. 1..255
+      udpOutPacket[13] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+      udpOutPacket[15] = 0x00; // Universe MSB, unused.
 
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
         size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
 
         if (currentPacket == (packetCount - 1U)) {
@@ -895,23 +1217,16 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
           }
         }
 
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        udpOutPacket[14] = (currentPacket) & 0xFF; // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
+        udpOutPacket[16] = 0xFF & (packetSize >> 8); // 16-bit length of channel data, MSB
+        udpOutPacket[17] = 0xFF & (packetSize     ); // 16-bit length of channel data, LSB
+        scaleChannels(udpOutPacket + ART_NET_HEADER_SIZE + 6, buffer + channel, packetSize, bri);
 
+        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
+          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
+          return 1; // borked
+        }
+        ddpUdp.write(udpOutPacket, ART_NET_HEADER_SIZE + 6 + packetSize);
         if (!ddpUdp.endPacket()) {
           DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
           return 1; // borked
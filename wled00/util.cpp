@@ -162,7 +162,10 @@ bool requestJSONBufferLock(uint8_t moduleID)
   // Use a recursive mutex type in case our task is the one holding the JSON buffer.
   // This can happen during large JSON web transactions.  In this case, we continue immediately
   // and then will return out below if the lock is still held.
-  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) return false;  // timed out waiting
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) {  // timed out waiting
+    jsonLockFailures++;
+    return false;
+  }
 #elif defined(ARDUINO_ARCH_ESP8266)
   // If we're in system context, delay() won't return control to the user context, so there's
   // no point in waiting.
@@ -175,6 +178,7 @@ bool requestJSONBufferLock(uint8_t moduleID)
 #endif  
   // If the lock is still held - by us, or by another task
   if (jsonBufferLock) {
+    jsonLockFailures++;
     DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), moduleID, jsonBufferLock);
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
@@ -199,6 +203,84 @@ void releaseJSONBufferLock()
 }
 
 
+#if WLED_JSON_POOL_SIZE > 0
+static JsonDocument *jsonPool[WLED_JSON_POOL_SIZE] = {nullptr};
+static uint8_t jsonPoolOwner[WLED_JSON_POOL_SIZE] = {0}; // module holding the document (0 = free)
+#ifdef ARDUINO_ARCH_ESP32
+// pool slots are claimed from async_tcp and loop task
+static portMUX_TYPE jsonPoolMux = portMUX_INITIALIZER_UNLOCKED;
+static inline void lockJsonPool()   { portENTER_CRITICAL(&jsonPoolMux); }
+static inline void unlockJsonPool() { portEXIT_CRITICAL(&jsonPoolMux); }
+#else
+static inline void lockJsonPool()   {}
+static inline void unlockJsonPool() {}
+#endif
+#endif
+
+// JSON document for an informational (read-only) response: a free pool document if there is one,
+// otherwise the global buffer, nullptr if the JSON buffer lock could not be acquired
+// pool documents do not take the JSON buffer lock, so serializing and sending /json and WebSocket updates
+// never delays control requests; only the global buffer fallback waits for (and holds) the lock
+// control requests (JSON/HTTP API, WebSocket and MQTT commands, presets, config, IR, serial, UDP JSON)
+// keep using requestJSONBufferLock() and pDoc
+// while segments are being restructured (strip suspended) the global buffer is used, which waits for the
+// control request doing it; other state may change during serialization and is corrected by the next update
+JsonDocument *requestJSONDocument(uint8_t moduleID)
+{
+#if WLED_JSON_POOL_SIZE > 0
+  int slot = -1;
+  if (!strip.isSuspended()) {
+    lockJsonPool();
+    for (int i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+      if (!jsonPoolOwner[i]) {
+        jsonPoolOwner[i] = moduleID ? moduleID : 255;
+        slot = i;
+        break;
+      }
+    }
+    unlockJsonPool();
+  }
+
+  if (slot >= 0) {
+    JsonDocument *doc = jsonPool[slot];
+    // without PSRAM only allocate if enough heap is left for the web server
+    if (!doc && ((psramSafe && psramFound()) || ESP.getMaxAllocHeap() > JSON_BUFFER_SIZE + WLED_REQUEST_MIN_HEAP)) {
+      PSRAMDynamicJsonDocument *newDoc = new PSRAMDynamicJsonDocument(JSON_BUFFER_SIZE);
+      if (newDoc && newDoc->capacity() == 0) { delete newDoc; newDoc = nullptr; } // buffer allocation failed
+      jsonPool[slot] = doc = newDoc;
+      DEBUG_PRINTF_P(PSTR("JSON pool document %d %s.\n"), slot, doc ? "allocated" : "allocation failed");
+    }
+    if (doc) {
+      jsonPoolCheckouts++;
+      doc->clear();
+      return doc;
+    }
+    lockJsonPool();
+    jsonPoolOwner[slot] = 0;
+    unlockJsonPool();
+  }
+  jsonPoolMisses++;
+#endif
+  if (!requestJSONBufferLock(moduleID)) return nullptr;
+  return pDoc;
+}
+
+void releaseJSONDocument(JsonDocument *doc)
+{
+#if WLED_JSON_POOL_SIZE > 0
+  for (int i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (doc == jsonPool[i]) {
+      lockJsonPool();
+      jsonPoolOwner[i] = 0;
+      unlockJsonPool();
+      return;
+    }
+  }
+#endif
+  releaseJSONBufferLock();
+}
+
+
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)!
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen)
@@ -410,6 +492,15 @@ uint8_t beatsin8_t(accum88 beats_per_minute, uint8_t lowest, uint8_t highest, ui
     return result;
 }
 
+// beatsin8_t() for a span of pixels with phase offset increasing by phase_step for each pixel
+void beatsin8Span(uint8_t *out, size_t len, accum88 beats_per_minute, uint8_t lowest, uint8_t highest, uint32_t timebase, uint8_t phase_offset, uint8_t phase_step, uint8_t tier)
+{
+    uint8_t beat = beat8( beats_per_minute, timebase);
+    uint8_t rangewidth = highest - lowest;
+    sin8Span(out, len, beat + phase_offset, phase_step, tier);
+    for (size_t i = 0; i < len; i++) out[i] = lowest + scale8( out[i], rangewidth);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Begin simulateSound (to enable audio enhanced effects to display something)
 ///////////////////////////////////////////////////////////////////////////////
@@ -706,20 +797,31 @@ static inline __attribute__((always_inline)) int32_t gradient1D(uint32_t x0, int
   return (hashToGradient(h) * dx) >> PERLIN_SHIFT;
 }
 
-static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
+// hash of 2D and 3D lattice corner coordinates, used to derive the corner gradient
+static inline __attribute__((always_inline)) uint32_t hashCorner2D(uint32_t x0, uint32_t y0) {
   uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D);
   h ^= h >> 15;
   h *= 0x92C3412B;
   h ^= h >> 13;
-  return (hashToGradient(h) * dx + hashToGradient(h>>PERLIN_SHIFT) * dy) >> (1 + PERLIN_SHIFT);
+  return h;
 }
 
-static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
+static inline __attribute__((always_inline)) uint32_t hashCorner3D(uint32_t x0, uint32_t y0, uint32_t z0) {
   // fast and good entropy hash from corner coordinates
   uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D) ^ (z0 * 0x1B56C4E9);
   h ^= h >> 15;
   h *= 0x92C3412B;
   h ^= h >> 13;
+  return h;
+}
+
+static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
+  uint32_t h = hashCorner2D(x0, y0);
+  return (hashToGradient(h) * dx + hashToGradient(h>>PERLIN_SHIFT) * dy) >> (1 + PERLIN_SHIFT);
+}
+
+static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
+  uint32_t h = hashCorner3D(x0, y0, z0);
   return ((hashToGradient(h) * dx + hashToGradient(h>>(1+PERLIN_SHIFT)) * dy + hashToGradient(h>>(1 + 2*PERLIN_SHIFT)) * dz) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
 }
 
@@ -831,6 +933,108 @@ int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit) {
   return noise;
 }
 
+/*
+ * Row (batch) versions of 2D and 3D Perlin noise: sample i is taken at x + i*stepX (y and z are constant)
+ * results are identical to per sample calls but corner hashes are only calculated when x crosses into a new
+ * lattice cell (reusing the shared edge) and the y/z part of each gradient dot product is calculated once per row
+ * output is scaled as ((raw * mul) >> 10 + ofs) >> shift to match perlin16()/perlin8()
+ */
+template<typename T>
+static void perlin2D_row(T *out, unsigned len, uint32_t x, uint32_t stepX, uint32_t y, bool is16bit, int32_t mul, int32_t ofs, unsigned shift) {
+  const uint32_t xMask = is16bit ? 0x00FFFFFF : 0xFFFFFFFF; // 8bit noise uses 16bit coordinates shifted by 8, wrap accordingly
+  const uint32_t y0 = y >> 16;
+  const uint32_t y1 = is16bit ? (y0 + 1) & 0xFF : y0 + 1;
+  const int32_t  dy0 = y & 0xFFFF;
+  const int32_t  dy1 = dy0 - 0x10000;
+  const uint32_t ty  = smoothstep(dy0);
+  int32_t gx0[2] = {0}, gy0[2] = {0}, gx1[2] = {0}, gy1[2] = {0}; // x gradient and y part of dot product for corners (y0,y1) at x0 and x1
+  const auto corners = [&](uint32_t cx, int32_t *gx, int32_t *gy) {
+    uint32_t h = hashCorner2D(cx, y0);
+    gx[0] = hashToGradient(h);
+    gy[0] = hashToGradient(h>>PERLIN_SHIFT) * dy0;
+    h = hashCorner2D(cx, y1);
+    gx[1] = hashToGradient(h);
+    gy[1] = hashToGradient(h>>PERLIN_SHIFT) * dy1;
+  };
+  uint32_t cellX0 = 0, cellX1 = 0;
+  bool valid = false;
+  for (unsigned i = 0; i < len; i++, x += stepX) {
+    x &= xMask;
+    const uint32_t x0 = x >> 16;
+    if (!valid || x0 != cellX0) {
+      const uint32_t x1 = is16bit ? (x0 + 1) & 0xFF : x0 + 1;
+      if (valid && x0 == cellX1) { // moved to next cell: shared edge is already known
+        gx0[0] = gx1[0]; gx0[1] = gx1[1];
+        gy0[0] = gy1[0]; gy0[1] = gy1[1];
+      } else corners(x0, gx0, gy0);
+      corners(x1, gx1, gy1);
+      cellX0 = x0;
+      cellX1 = x1;
+      valid = true;
+    }
+    const int32_t dx0 = x & 0xFFFF;
+    const int32_t dx1 = dx0 - 0x10000;
+    const uint32_t tx = smoothstep(dx0);
+    const int32_t g00 = (gx0[0] * dx0 + gy0[0]) >> (1 + PERLIN_SHIFT);
+    const int32_t g10 = (gx1[0] * dx1 + gy1[0]) >> (1 + PERLIN_SHIFT);
+    const int32_t g01 = (gx0[1] * dx0 + gy0[1]) >> (1 + PERLIN_SHIFT);
+    const int32_t g11 = (gx1[1] * dx1 + gy1[1]) >> (1 + PERLIN_SHIFT);
+    const int32_t noise = lerpPerlin(lerpPerlin(g00, g10, tx), lerpPerlin(g01, g11, tx), ty);
+    out[i] = (((noise * mul) >> 10) + ofs) >> shift;
+  }
+}
+
+template<typename T>
+static void perlin3D_row(T *out, unsigned len, uint32_t x, uint32_t stepX, uint32_t y, uint32_t z, bool is16bit, int32_t mul, int32_t ofs, unsigned shift) {
+  const uint32_t xMask = is16bit ? 0x00FFFFFF : 0xFFFFFFFF; // 8bit noise uses 16bit coordinates shifted by 8, wrap accordingly
+  const uint32_t y0 = y >> 16;
+  const uint32_t z0 = z >> 16;
+  const uint32_t y1 = is16bit ? (y0 + 1) & 0xFF : y0 + 1;
+  const uint32_t z1 = is16bit ? (z0 + 1) & 0xFF : z0 + 1;
+  const int32_t  dy0 = y & 0xFFFF;
+  const int32_t  dz0 = z & 0xFFFF;
+  const int32_t  dy1 = dy0 - 0x10000;
+  const int32_t  dz1 = dz0 - 0x10000;
+  const uint32_t ty  = smoothstep(dy0);
+  const uint32_t tz  = smoothstep(dz0);
+  // corner order (y,z): (y0,z0), (y1,z0), (y0,z1), (y1,z1)
+  int32_t gx0[4] = {0}, gyz0[4] = {0}, gx1[4] = {0}, gyz1[4] = {0}; // x gradient and y/z part of dot product for corners at x0 and x1
+  const auto corners = [&](uint32_t cx, int32_t *gx, int32_t *gyz) {
+    for (int k = 0; k < 4; k++) {
+      const uint32_t h = hashCorner3D(cx, k & 1 ? y1 : y0, k & 2 ? z1 : z0);
+      gx[k]  = hashToGradient(h);
+      gyz[k] = hashToGradient(h>>(1+PERLIN_SHIFT)) * (k & 1 ? dy1 : dy0) + hashToGradient(h>>(1 + 2*PERLIN_SHIFT)) * (k & 2 ? dz1 : dz0);
+    }
+  };
+  uint32_t cellX0 = 0, cellX1 = 0;
+  bool valid = false;
+  for (unsigned i = 0; i < len; i++, x += stepX) {
+    x &= xMask;
+    const uint32_t x0 = x >> 16;
+    if (!valid || x0 != cellX0) {
+      const uint32_t x1 = is16bit ? (x0 + 1) & 0xFF : x0 + 1;
+      if (valid && x0 == cellX1) { // moved to next cell: shared edge is already known
+        for (int k = 0; k < 4; k++) { gx0[k] = gx1[k]; gyz0[k] = gyz1[k]; }
+      } else corners(x0, gx0, gyz0);
+      corners(x1, gx1, gyz1);
+      cellX0 = x0;
+      cellX1 = x1;
+      valid = true;
+    }
+    const int32_t dx0 = x & 0xFFFF;
+    const int32_t dx1 = dx0 - 0x10000;
+    const uint32_t tx = smoothstep(dx0);
+    int32_t nx[4];
+    for (int k = 0; k < 4; k++) {
+      const int32_t g0 = ((gx0[k] * dx0 + gyz0[k]) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
+      const int32_t g1 = ((gx1[k] * dx1 + gyz1[k]) * 85) >> (8 + PERLIN_SHIFT);
+      nx[k] = lerpPerlin(g0, g1, tx);
+    }
+    const int32_t noise = lerpPerlin(lerpPerlin(nx[0], nx[1], ty), lerpPerlin(nx[2], nx[3], ty), tz);
+    out[i] = (((noise * mul) >> 10) + ofs) >> shift;
+  }
+}
+
 // scaling functions for fastled replacement
 uint16_t perlin16(uint32_t x) {
   return ((perlin1D_raw(x) * 1159) >> 10) + 32803; //scale to 16bit and offset (fastled range: about 4838 to 60766)
@@ -854,4 +1058,24 @@ uint8_t perlin8(uint16_t x, uint16_t y) {
 
 uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z) {
   return (((perlin3D_raw((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, true) * 2015) >> 10) + 33168) >> 8; //scale to 16 bit, offset, then scale to 8bit
-}
\ No newline at end of file
+}
+// batch versions: fill a row (or grid) of noise values, sample i is at x + i*stepX (and row j at y + j*stepY)
+void perlin16Row(uint16_t *out, unsigned len, uint32_t x, uint32_t stepX, uint32_t y) {
+  perlin2D_row(out, len, x, stepX, y, false, 1537, 32725, 0);
+}
+
+void perlin16Row(uint16_t *out, unsigned len, uint32_t x, uint32_t stepX, uint32_t y, uint32_t z) {
+  perlin3D_row(out, len, x, stepX, y, z, false, 1731, 33147, 0);
+}
+
+void perlin8Row(uint8_t *out, unsigned len, uint16_t x, uint16_t stepX, uint16_t y) {
+  perlin2D_row(out, len, (uint32_t)x << 8, (uint32_t)stepX << 8, (uint32_t)y << 8, true, 1620, 32771, 8);
+}
+
+void perlin8Row(uint8_t *out, unsigned len, uint16_t x, uint16_t stepX, uint16_t y, uint16_t z) {
+  perlin3D_row(out, len, (uint32_t)x << 8, (uint32_t)stepX << 8, (uint32_t)y << 8, (uint32_t)z << 8, true, 2015, 33168, 8);
+}
+
+void perlin8Grid(uint8_t *out, unsigned cols, unsigned rows, uint16_t x, uint16_t stepX, uint16_t y, uint16_t stepY, uint16_t z) {
+  for (unsigned j = 0; j < rows; j++, y += stepY) perlin8Row(out + j * cols, cols, x, stepX, y, z);
+}
@@ -321,6 +321,9 @@ void WLED::setup()
   #ifdef WLED_BOOTUPDELAY
   delay(WLED_BOOTUPDELAY); // delay to let voltage stabilize, helps with boot issues on some setups
   #endif
+  #if !ARDUINO_USB_CDC_ON_BOOT
+  Serial.setRxBufferSize(SERIAL_RX_BUFFER); // must be set before begin(), holds Adalight/TPM2 frames at high baud rates
+  #endif
   Serial.begin(115200);
   #if !ARDUINO_USB_CDC_ON_BOOT
   Serial.setTimeout(50);  // this causes troubles on new MCUs that have a "virtual" USB Serial (HWCDC)
@@ -460,6 +460,14 @@ WLED_GLOBAL byte alexaNumPresets _INIT(0);                        // number of p
 WLED_GLOBAL uint16_t realtimeTimeoutMs _INIT(2500);               // ms timeout of realtime mode before returning to normal mode
 WLED_GLOBAL int arlsOffset _INIT(0);                              // realtime LED offset
 WLED_GLOBAL bool arlsDisableGammaCorrection _INIT(true);          // activate if gamma correction is handled by the source
+WLED_GLOBAL uint16_t udpReceiveBudget _INIT(UDP_RECEIVE_BUDGET);  // us per loop spent draining queued UDP packets
+WLED_GLOBAL uint32_t udpPacketsReceived _INIT(0);                 // UDP notifier/realtime packets handled
+WLED_GLOBAL uint32_t udpPacketsDropped _INIT(0);                  // UDP packets discarded because of invalid size
+WLED_GLOBAL uint16_t udpMaxBurst _INIT(0);                        // most UDP packets handled in one loop (queue depth)
+WLED_GLOBAL uint32_t e131PacketsLost _INIT(0);                    // E1.31/Art-Net/DDP packets missing according to sequence numbers
+WLED_GLOBAL byte realtimeJitterFrames _INIT(0);                   // DDP/E1.31/Art-Net frames buffered to even out output timing (0 = show on arrival)
+WLED_GLOBAL uint32_t realtimeJitter _INIT(0);                     // us average deviation of realtime frame arrival from the frame interval
+WLED_GLOBAL uint16_t realtimeLatency _INIT(0);                    // ms realtime frames are held back by the jitter buffer
 WLED_GLOBAL bool arlsForceMaxBri _INIT(false);                    // enable to force max brightness if source has very dark colors that would be black
 
 #ifdef WLED_ENABLE_DMX
@@ -495,7 +503,10 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL bool e131WaitForFrame _INIT(true);                    // show E1.31/Art-Net data once all universes of a frame arrived
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
+WLED_GLOBAL uint32_t e131UniversesLate _INIT(0);                  // universes that arrived after their frame was shown
+WLED_GLOBAL uint32_t e131UniversesDropped _INIT(0);               // universes missing from shown frames
 
 // mqtt
 WLED_GLOBAL unsigned long lastMqttReconnectAttempt _INIT(0);  // used for other periodic tasks too
@@ -974,6 +985,9 @@ WLED_GLOBAL StaticJsonDocument<JSON_BUFFER_SIZE> gDoc;
 WLED_GLOBAL JsonDocument *pDoc _INIT(&gDoc);
 #endif
 WLED_GLOBAL volatile uint8_t jsonBufferLock _INIT(0);
+WLED_GLOBAL uint32_t jsonLockFailures _INIT(0);  // requests that could not get the global JSON buffer
+WLED_GLOBAL uint32_t jsonPoolCheckouts _INIT(0); // informational responses served from a pool document
+WLED_GLOBAL uint32_t jsonPoolMisses _INIT(0);    // informational responses that had to use the global JSON buffer
 
 // enable additional debug output
 #if defined(WLED_DEBUG_HOST)
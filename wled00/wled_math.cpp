@@ -7,6 +7,7 @@
  */
 
 #include <Arduino.h> //PI constant
+#include "const.h"     //MATH_EXACT, MATH_FAST
 
 //#define WLED_DEBUG_MATH
 
@@ -244,3 +245,77 @@ uint32_t sqrt32_bw(uint32_t x) {
   }
   return res;
 }
+
+/*
+ * Batch (span) variants of the above functions for use in per-pixel loops
+ * spans are arithmetic progressions (start + i*step) which is what effects typically use, or arrays of coordinates
+ * accuracy tiers:
+ *  MATH_EXACT: same result as the scalar function
+ *  MATH_FAST:  table or polynomial based, no float math; sine error <5/32767, atan2 error <1 (of 256 per circle), hypot error <4% +1
+ */
+
+// quarter sine wave, 64 segments: sin(i*pi/128)*32767
+static const uint16_t sinQuarterTable[65] PROGMEM = {
+      0,   804,  1608,  2410,  3212,  4011,  4808,  5602,  6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+  12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+  23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+  32767
+};
+
+static inline int16_t sin16_fast(uint16_t theta) {
+  unsigned idx = theta & 0x3FFF;           // position within quadrant (14 bit)
+  if (theta & 0x4000) idx = 0x4000 - idx;  // 2nd and 4th quadrant are mirrored
+  unsigned i = idx >> 8;
+  int32_t a = pgm_read_word(&sinQuarterTable[i]);
+  int32_t result = (i < 64) ? a + (((int32_t(pgm_read_word(&sinQuarterTable[i+1])) - a) * int32_t(idx & 0xFF)) >> 8) : a;
+  return (theta & 0x8000) ? -result : result; // 2nd half is negative
+}
+
+static inline uint8_t sin16to8(int32_t sin16) {
+  sin16 += 0x7FFF + 128; //shift result to range 0-0xFFFF, +128 for rounding (same as sin8_t())
+  return min(sin16, int32_t(0xFFFF)) >> 8;
+}
+
+void sin8Span(uint8_t *out, size_t len, uint8_t theta, uint8_t step, uint8_t tier) {
+  if (tier == MATH_EXACT) for (size_t i = 0; i < len; i++, theta += step) out[i] = sin8_t(theta);
+  else                    for (size_t i = 0; i < len; i++, theta += step) out[i] = sin16to8(sin16_fast((uint16_t)theta * 257));
+}
+
+void cos8Span(uint8_t *out, size_t len, uint8_t theta, uint8_t step, uint8_t tier) {
+  sin8Span(out, len, theta + 64, step, tier); //cos(x) = sin(x+pi/2)
+}
+
+// angle of each (x,y) vector, 0-255 covers full circle (0 = positive x axis), same scaling as int(40.7436f * atan2_t(y, x))
+void atan2Span(uint8_t *out, const int16_t *y, const int16_t *x, size_t len, uint8_t tier) {
+  if (tier == MATH_EXACT) {
+    for (size_t i = 0; i < len; i++) out[i] = int(40.7436f * atan2_t(y[i], x[i]));
+    return;
+  }
+  for (size_t i = 0; i < len; i++) {
+    uint32_t ax = abs(x[i]);
+    uint32_t ay = abs(y[i]);
+    uint32_t hi = max(ax, ay);
+    uint32_t lo = min(ax, ay);
+    // atan(r) ~ pi/4*r + 0.273*r*(1-r) for r = lo/hi in [0,1], in units of 256 per circle (pi/4 = 32, 0.273 = 11.12)
+    uint32_t r = hi ? (lo << 16) / hi : 0; // Q16
+    int32_t a = ((32 * r) + ((11387 * ((r * (65536 - r)) >> 16)) >> 10) + 0x8000) >> 16; // 11387/1024 = 11.12, rounded
+    if (ay > ax) a = 64 - a;     // angle is measured from y axis
+    if (x[i] < 0)  a = 128 - a;  // 2nd/3rd quadrant
+    if (y[i] < 0)  a = -a;       // 3rd/4th quadrant
+    out[i] = a;
+  }
+}
+
+// length of each (x,y) vector
+void hypotSpan(uint16_t *out, const int16_t *x, const int16_t *y, size_t len, uint8_t tier) {
+  for (size_t i = 0; i < len; i++) {
+    int32_t dx = x[i];
+    int32_t dy = y[i];
+    if (tier == MATH_EXACT) out[i] = sqrt32_bw(uint32_t(dx * dx) + uint32_t(dy * dy)); // squares fit int32, their sum only fits uint32
+    else {
+      uint32_t ax = abs(dx), ay = abs(dy);
+      out[i] = (max(ax, ay) * 123 + min(ax, ay) * 51 + 64) >> 7; // alpha max plus beta min (0.961, 0.398)
+    }
+  }
+}
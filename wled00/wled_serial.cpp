@@ -4,6 +4,8 @@
  * Adalight and TPM2 handler
  */
 
+#define SERIAL_BLOCK_LEN 192 // bytes of pixel data decoded per block read (multiple of 3)
+
 enum class AdaState {
   Header_A,
   Header_d,
@@ -21,8 +23,28 @@ enum class AdaState {
 
 uint16_t currentBaud = 1152; //default baudrate 115200 (divided by 100)
 bool continuousSendLED = false;
+bool continuousSendDelta = false;
 uint32_t lastUpdate = 0;
 
+/*
+ * Delta streaming, a WLED extension of TPM2 (not part of the TPM2 specification)
+ * Serial command 'D' enables continuous streaming like 'O', but after a full TPM2 data frame (keyframe, type 0xDA)
+ * only the pixel runs that changed since the previous frame are sent, in frames of packet type TPM2_DELTA_TYPE (0xDD):
+ * 0xC9 0xDD <payload length hi> <lo> { <start pixel hi> <lo> <run length 1-255> <RGB * run length> } 0x36 '\n'
+ * A keyframe is sent every SERIAL_DELTA_KEYFRAME frames, when the LED count changes or when a delta would not be smaller.
+ * The payload length is 16 bit as in TPM2, so LED counts above 21845 (whose keyframe would not fit) are not streamed.
+ * Any other received byte (e.g. 'o') stops streaming. tools/serial_delta_decode.py decodes the stream on the host.
+ */
+#define TPM2_DELTA_TYPE 0xDD
+#define SERIAL_DELTA_KEYFRAME 100
+#define TPM2_MAX_PAYLOAD 0xFFFF
+
+static uint8_t *streamBuffer = nullptr; // two RGB frames: as last sent and current
+static uint8_t *streamPrev = nullptr;   // RGB of every LED as last sent
+static uint8_t *streamNext = nullptr;   // RGB of every LED in the current frame
+static unsigned streamLength = 0;
+static unsigned streamFrameCount = 0;   // frames sent since the last keyframe
+
 void updateBaudRate(uint32_t rate){
   unsigned rate100 = rate/100;
   if (rate100 == currentBaud || rate100 < 96) return;
@@ -49,6 +71,14 @@ void sendJSON(){
   }
 }
 
+// RGB of an LED as streamed to the host, white is added to RGB as a simple RGBW -> RGB map
+static void getStreamPixel(unsigned i, uint8_t *rgb) {
+  uint32_t c = strip.getPixelColor(i);
+  rgb[0] = qadd8(W(c), R(c));
+  rgb[1] = qadd8(W(c), G(c));
+  rgb[2] = qadd8(W(c), B(c));
+}
+
 // RGB LED data returned as bytes in TPM2 format. Faster, and slightly less easy to use on the other end.
 void sendBytes(){
   if (serialCanTX) {
@@ -58,15 +88,85 @@ void sendBytes(){
     Serial.write(highByte(len));
     Serial.write(lowByte(len));
     for (unsigned i=0; i < used; i++) {
-      uint32_t c = strip.getPixelColor(i);
-      Serial.write(qadd8(W(c), R(c))); //R, add white channel to RGB channels as a simple RGBW -> RGB map
-      Serial.write(qadd8(W(c), G(c))); //G
-      Serial.write(qadd8(W(c), B(c))); //B
+      uint8_t rgb[3];
+      getStreamPixel(i, rgb);
+      Serial.write(rgb, 3);
     }
     Serial.write(0x36); Serial.write('\n');
   }
 }
 
+// finds the next run of pixels changed between RGB frames prev and next, starting at or after pixel i
+// returns its length (0 if there is none), runs are at most 255 pixels and may include single unchanged pixels
+static unsigned findChangedRun(const uint8_t *prev, const uint8_t *next, unsigned &i, unsigned used) {
+  auto changed = [prev, next](unsigned p) { return memcmp(prev + p*3, next + p*3, 3) != 0; };
+  while (i < used && !changed(i)) i++;
+  if (i >= used) return 0;
+  unsigned last = i; // last changed pixel of the run
+  for (unsigned end = i+1; end < used && end - i < 255; end++) {
+    if (changed(end)) last = end;
+    else if (end - last > 1) break; // a single unchanged pixel costs as much as a new run header
+  }
+  return last - i + 1;
+}
+
+// payload bytes of a delta frame from RGB frame prev to next
+static size_t getDeltaPayloadSize(const uint8_t *prev, const uint8_t *next, unsigned used) {
+  size_t payload = 0;
+  for (unsigned i = 0, n; (n = findChangedRun(prev, next, i, used)); i += n) payload += 3 + n*3;
+  return payload;
+}
+
+// LED data returned as TPM2 delta frame of the pixel runs changed since the last frame sent, see above
+void sendDelta(){
+  if (!serialCanTX) return;
+  unsigned used = strip.getLengthTotal();
+  if (used*3 > TPM2_MAX_PAYLOAD) return; // not even a keyframe fits a TPM2 frame
+  if (used != streamLength) {
+    p_free(streamBuffer);
+    streamBuffer = static_cast<uint8_t*>(p_malloc(used*3*2));
+    streamLength = streamBuffer ? used : 0;
+    streamPrev = streamBuffer;
+    streamNext = streamBuffer ? streamBuffer + used*3 : nullptr;
+    streamFrameCount = SERIAL_DELTA_KEYFRAME; // start with a keyframe
+  }
+  if (!streamBuffer) { // not enough memory, send full frames
+    sendBytes();
+    return;
+  }
+
+  for (unsigned i = 0; i < used; i++) getStreamPixel(i, streamNext + i*3); // one snapshot of the frame
+  size_t payload = SIZE_MAX;
+  if (++streamFrameCount < SERIAL_DELTA_KEYFRAME) payload = getDeltaPayloadSize(streamPrev, streamNext, used);
+
+  Serial.write(0xC9);
+  if (payload < used*3 && payload <= TPM2_MAX_PAYLOAD) {
+    Serial.write(TPM2_DELTA_TYPE);
+    Serial.write(highByte(payload));
+    Serial.write(lowByte(payload));
+    for (unsigned i = 0, n; (n = findChangedRun(streamPrev, streamNext, i, used)); i += n) {
+      Serial.write(highByte(i)); Serial.write(lowByte(i));
+      Serial.write((uint8_t)n);
+      Serial.write(streamNext + i*3, n*3);
+    }
+  } else { // keyframe
+    Serial.write(0xDA);
+    Serial.write(highByte(used*3));
+    Serial.write(lowByte(used*3));
+    Serial.write(streamNext, used*3);
+    streamFrameCount = 0;
+  }
+  Serial.write(0x36); Serial.write('\n');
+  std::swap(streamPrev, streamNext); // the frame just sent is the base of the next delta
+}
+
+static void stopDeltaStream() {
+  continuousSendDelta = false;
+  p_free(streamBuffer);
+  streamBuffer = streamPrev = streamNext = nullptr;
+  streamLength = 0;
+}
+
 void handleSerial()
 {
   if (!(serialCanRX && Serial)) return; // arduino docs: `if (Serial)` indicates whether or not the USB CDC serial connection is open. For all non-USB CDC ports, this will always return true
@@ -81,6 +181,26 @@ void handleSerial()
   while (Serial.available() > 0)
   {
     yield();
+    if (state == AdaState::Data_Red) {
+      // decode whole pixel runs from a block read instead of going through the state machine byte by byte
+      byte buf[SERIAL_BLOCK_LEN];
+      unsigned len = min((unsigned)Serial.available(), min(count * 3U, (unsigned)sizeof(buf)));
+      len -= len % 3;
+      if (len) {
+        len = Serial.readBytes(buf, len);
+        const unsigned pixels = len / 3;
+        if (!realtimeOverride) setRealtimePixels(pixel, buf, pixels, 3);
+        pixel += pixels;
+        count -= pixels;
+        continuousSendLED = false;
+        if (count == 0) {
+          realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+          if (!realtimeOverride) strip.show();
+          state = AdaState::Header_A;
+        }
+        continue;
+      }
+    }
     byte next = Serial.peek();
     switch (state) {
       case AdaState::Header_A:
@@ -96,10 +216,13 @@ void handleSerial()
         else if (next == 0xB5) { updateBaudRate( 921600); }
         else if (next == 0xB6) { updateBaudRate(1000000); }
         else if (next == 0xB7) { updateBaudRate(1500000); }
+        else if (next == 0xB8) { updateBaudRate(2000000); }
+        else if (next == 0xB9) { updateBaudRate(3000000); }
         else if (next == 'l')  { sendJSON(); } // Send LED data as JSON Array
         else if (next == 'L')  { sendBytes(); } // Send LED data as TPM2 Data Packet
         else if (next == 'o')  { continuousSendLED = false; } // Disable Continuous Serial Streaming
-        else if (next == 'O')  { continuousSendLED = true; } // Enable Continuous Serial Streaming
+        else if (next == 'O')  { continuousSendLED = true; continuousSendDelta = false; } // Enable Continuous Serial Streaming
+        else if (next == 'D')  { continuousSendLED = true; continuousSendDelta = true; } // Enable Continuous Serial Streaming of changed pixels only
         else if (next == '{')  { //JSON API
           bool verboseResponse = false;
           if (!requestJSONBufferLock(16)) {
@@ -155,12 +278,12 @@ void handleSerial()
         break;
       case AdaState::TPM2_Header_CountHi:
         pixel = 0;
-        count = (next * 0x100) /3;
+        count = next * 0x100;
         state = AdaState::TPM2_Header_CountLo;
         break;
       case AdaState::TPM2_Header_CountLo:
-        count += next /3;
-        state = AdaState::Data_Red;
+        count = (count + next) /3; // payload bytes to pixels
+        state = count ? AdaState::Data_Red : AdaState::Header_A;
         break;
       case AdaState::Data_Red:
         red   = next;
@@ -184,7 +307,7 @@ void handleSerial()
     }
 
     // All other received bytes will disable Continuous Serial Streaming
-    if (continuousSendLED && next != 'O'){
+    if (continuousSendLED && next != 'O' && next != 'D'){
       continuousSendLED = false;
     }
 
@@ -193,7 +316,9 @@ void handleSerial()
 
   // If Continuous Serial Streaming is enabled, send new LED data as bytes
   if (continuousSendLED && (lastUpdate != strip.getLastShow())){
-    sendBytes();
+    if (continuousSendDelta) sendDelta();
+    else                     sendBytes();
     lastUpdate = strip.getLastShow();
   }
+  if (!continuousSendLED && streamBuffer) stopDeltaStream();
 }
@@ -105,7 +105,8 @@ void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
 
-  if (!requestJSONBufferLock(12)) {
+  JsonDocument *doc = requestJSONDocument(12);
+  if (!doc) {
     const char* error = PSTR("{\"error\":3}");
     if (client) {
       client->text(FPSTR(error)); // ERR_NOBUF
@@ -115,19 +116,20 @@ void sendDataWs(AsyncWebSocketClient * client)
     return;
   }
 
-  JsonObject state = pDoc->createNestedObject("state");
+  JsonObject state = doc->createNestedObject("state");
   serializeState(state);
-  JsonObject info  = pDoc->createNestedObject("info");
+  JsonObject info  = doc->createNestedObject("info");
   serializeInfo(info);
 
-  size_t len = measureJson(*pDoc);
-  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), pDoc->memoryUsage(), len);
+  size_t len = measureJson(*doc);
+  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), doc->memoryUsage(), len);
 
   // the following may no longer be necessary as heap management has been fixed by @willmmiles in AWS
   size_t heap1 = ESP.getFreeHeap();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), ESP.getFreeHeap());
   #ifdef ESP8266
   if (len>heap1) {
+    releaseJSONDocument(doc);
     DEBUG_PRINTLN(F("Out of memory (WS)!"));
     return;
   }
@@ -140,13 +142,13 @@ void sendDataWs(AsyncWebSocketClient * client)
   size_t heap2 = 0; // ESP32 variants do not have the same issue and will work without checking heap allocation
   #endif
   if (!buffer || heap1-heap2<len) {
-    releaseJSONBufferLock();
+    releaseJSONDocument(doc);
     DEBUG_PRINTLN(F("WS buffer allocation failed."));
     ws.closeAll(1013); //code 1013 = temporary overload, try again later
     ws.cleanupClients(0); //disconnect all clients to release memory
     return; //out of memory
   }
-  serializeJson(*pDoc, (char *)buffer.data(), len);
+  serializeJson(*doc, (char *)buffer.data(), len);
 
   DEBUG_PRINT(F("Sending WS data "));
   if (client) {
@@ -157,7 +159,7 @@ void sendDataWs(AsyncWebSocketClient * client)
     ws.textAll(std::move(buffer));
   }
 
-  releaseJSONBufferLock();
+  releaseJSONDocument(doc);
 }
 
 bool sendLiveLedsWs(uint32_t wsClient)
@@ -311,6 +311,9 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       char sp[4] = "SP"; sp[2] = offset+s; sp[3] = 0; //bus clock speed
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED current
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max per-port PSU current
+      char eu[4] = "EU"; eu[2] = offset+s; eu[3] = 0; //E1.31 start universe
+      char ep[4] = "EP"; ep[2] = offset+s; ep[3] = 0; //E1.31 priority
+      char es[4] = "ES"; es[2] = offset+s; es[3] = 0; //E1.31 sync universe
       settingsScript.print(F("addLEDs(1);"));
       uint8_t pins[5];
       int nPins = bus->getPins(pins);
@@ -350,6 +353,12 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       printSetFormValue(settingsScript,sp,speed);
       printSetFormValue(settingsScript,la,bus->getLEDCurrent());
       printSetFormValue(settingsScript,ma,bus->getMaxCurrent());
+      if ((bus->getType() & 0x7F) == TYPE_NET_E131_RGB) {
+        const BusNetwork *net = static_cast<const BusNetwork *>(bus);
+        printSetFormValue(settingsScript,eu,net->getE131Universe());
+        printSetFormValue(settingsScript,ep,net->getE131Priority());
+        printSetFormValue(settingsScript,es,net->getE131SyncUniverse());
+      }
       sumMa += bus->getMaxCurrent();
     }
     printSetFormValue(settingsScript,PSTR("MA"),BusManager::ablMilliampsMax() ? BusManager::ablMilliampsMax() : sumMa);
@@ -435,6 +444,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormCheckbox(settingsScript,PSTR("RLM"),realtimeRespectLedMaps);
     printSetFormValue(settingsScript,PSTR("EP"),e131Port);
     printSetFormCheckbox(settingsScript,PSTR("ES"),e131SkipOutOfSequence);
+    printSetFormCheckbox(settingsScript,PSTR("EW"),e131WaitForFrame);
     printSetFormCheckbox(settingsScript,PSTR("EM"),e131Multicast);
     printSetFormValue(settingsScript,PSTR("EU"),e131Universe);
 #ifdef WLED_ENABLE_DMX
@@ -454,6 +464,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormValue(settingsScript,PSTR("PY"),e131Priority);
     printSetFormValue(settingsScript,PSTR("DM"),DMXMode);
     printSetFormValue(settingsScript,PSTR("ET"),realtimeTimeoutMs);
+    printSetFormValue(settingsScript,PSTR("JB"),realtimeJitterFrames);
     printSetFormCheckbox(settingsScript,PSTR("FB"),arlsForceMaxBri);
     printSetFormCheckbox(settingsScript,PSTR("RG"),arlsDisableGammaCorrection);
     printSetFormValue(settingsScript,PSTR("WO"),arlsOffset);